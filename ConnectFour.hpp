@@ -4,11 +4,30 @@
 #include <vector>
 #include <optional>
 #include <random>
-
-class ConnectFour {
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include "ConnectFourSolver.hpp"
+#include "ConnectFourAnalyzer.hpp"
+#include "ConnectFourComputer.hpp"
+#include "FramePacer.hpp"
+#include "HighScore.hpp"
+#include "PlayerProfiles.hpp"
+#include "Tween.hpp"
+#include "VariantLauncher.hpp"
+
+// Board dimensions are compile-time so each size gets its own bitboard type and win check
+template <int ROWS = 6, int COLS = 7>
+class BasicConnectFour {
 private:
+    using Position = BasicConnectFourPosition<COLS, ROWS>;
+    using Solver = BasicConnectFourSolver<COLS, ROWS>;
+    using Computer = BasicConnectFourComputer<COLS, ROWS>;
+    using Analyzer = BasicConnectFourAnalyzer<COLS, ROWS>;
+
     enum class Player { None, One, Two };
-    enum class GameState { Playing, GameOver };
+    enum class GameState { SelectMode, Playing, GameOver };
+    enum class GameMode { PvP, PvC, PvMCTS };
 
     struct Button {
         sf::RectangleShape shape;
@@ -17,8 +36,13 @@ private:
     };
 
     // Constants
-    static const int ROWS = 6;
-    static const int COLS = 7;
+    static const unsigned long long AI_NODE_BUDGET = 2000000;
+    static const unsigned MCTS_PLAYOUTS = 200000;
+    static constexpr float BOARD_MARGIN = 40.0f;
+    static constexpr float BOARD_TOP = 100.0f;
+    static constexpr float DROP_TIME_PER_SQRT_CELL = 0.3f;  // Free fall: time grows with sqrt(distance)
+    static constexpr float MAX_FRAME_TIME = 0.1f;  // Clamp long stalls so animations don't jump
+    static const int DISC_SEGMENTS = 32;
     float CELL_SIZE;
     float GRID_OFFSET_X;
     float GRID_OFFSET_Y;
@@ -26,65 +50,158 @@ private:
     // Animation struct
     struct DroppingDisc {
         int col;
-        float currentY;
-        float targetY;
+        Tween fall;
         Player player;
     };
 
     // Window and resources
     sf::RenderWindow& window;
     sf::Font& font;
+    FramePacer pacer;
 
     // Game state
     GameState currentState;
+    GameMode gameMode;
     Player currentPlayer;
     std::array<std::array<Player, COLS>, ROWS> grid;
     bool shouldExit;
 
+    // Engine state, kept in sync with the grid
+    Position position;
+    Computer computer;
+
     // Scores
     int player1Score;
     int player2Score;
 
     // UI Elements
+    Button pvpButton;
+    Button pvcButton;
+    Button mctsButton;
     Button continueButton;
     sf::Text statusText;
     sf::Text scoreText;
+    sf::Text analysisHint;
+
+    // Analysis overlay, evaluated on the analyzer's thread and polled each frame
+    Analyzer analyzer;
+    bool analysisEnabled;
+    unsigned shownAnalysisVersion;
+    bool analysisFinished;
+    std::array<sf::Text, COLS> analysisTexts;
 
     // Animation
     std::optional<DroppingDisc> droppingDisc;
 
+    // Cached rendering: empty holes are drawn once into a texture, discs go into one
+    // vertex array (placed discs first, falling disc appended at the end)
+    sf::RenderTexture boardTexture;
+    sf::Sprite boardSprite;
+    sf::VertexArray discVertices;
+    size_t placedVertexCount;
+
 public:
-    ConnectFour(sf::RenderWindow& gameWindow, sf::Font& gameFont)
-        : window(gameWindow), font(gameFont),
-          CELL_SIZE(80.0f),
+    BasicConnectFour(sf::RenderWindow& gameWindow, sf::Font& gameFont)
+        : CELL_SIZE(80.0f),
           GRID_OFFSET_X(200.0f),
-          GRID_OFFSET_Y(100.0f),
-          currentState(GameState::Playing), 
+          GRID_OFFSET_Y(BOARD_TOP),
+          window(gameWindow), font(gameFont), pacer(gameWindow),
+          currentState(GameState::SelectMode),
+          gameMode(GameMode::PvP),
           currentPlayer(Player::One), 
           shouldExit(false),
+          computer(AI_NODE_BUDGET, MCTS_PLAYOUTS),
           player1Score(0), 
-          player2Score(0) {
+          player2Score(0),
+          analysisEnabled(false),
+          shownAnalysisVersion(0),
+          analysisFinished(true),
+          discVertices(sf::Triangles),
+          placedVertexCount(0) {
         initializeGame();
     }
 
     bool run() {
-        while (window.isOpen() && !shouldExit) { 
+        sf::Clock clock;
+        while (window.isOpen() && !shouldExit) {
+            float deltaTime = std::min(clock.restart().asSeconds(), MAX_FRAME_TIME);
             handleEvents();
-            updateGame();
+            updateGame(deltaTime);
             render();
+            if (!shouldExit && !isAnimating()) {
+                pacer.waitEvent();
+                clock.restart();  // Time spent waiting moves nothing
+            }
         }
         return true;
     }
 
 private:
     void initializeGame() {
+        setupLayout();
+        setupBoardTexture();
         setupButtons();
         resetGrid();
         setupText();
     }
 
+    // Size cells so the whole board fits the window, whatever its dimensions
+    void setupLayout() {
+        float availableWidth = window.getSize().x - 2 * BOARD_MARGIN;
+        float availableHeight = window.getSize().y - BOARD_TOP - BOARD_MARGIN / 2;
+        CELL_SIZE = std::min(availableWidth / COLS, availableHeight / ROWS);
+        GRID_OFFSET_X = (window.getSize().x - COLS * CELL_SIZE) / 2;
+        GRID_OFFSET_Y = BOARD_TOP;
+    }
+
+    void setupBoardTexture() {
+        boardTexture.create(COLS * CELL_SIZE, ROWS * CELL_SIZE);
+        boardTexture.clear(sf::Color::Transparent);
+
+        sf::VertexArray holes(sf::Triangles);
+        for (int row = 0; row < ROWS; row++) {
+            for (int col = 0; col < COLS; col++) {
+                appendDisc(holes, sf::Vector2f((col + 0.5f) * CELL_SIZE, (row + 0.5f) * CELL_SIZE),
+                           sf::Color::White);
+            }
+        }
+        boardTexture.draw(holes);
+        boardTexture.display();
+
+        boardSprite.setTexture(boardTexture.getTexture(), true);
+        boardSprite.setPosition(GRID_OFFSET_X, GRID_OFFSET_Y);
+    }
+
+    void appendDisc(sf::VertexArray& vertices, const sf::Vector2f& center, const sf::Color& color) const {
+        const float radius = CELL_SIZE / 2 - 2;
+        const float step = 2.0f * 3.14159265f / DISC_SEGMENTS;
+        for (int i = 0; i < DISC_SEGMENTS; i++) {
+            vertices.append(sf::Vertex(center, color));
+            vertices.append(sf::Vertex(center + sf::Vector2f(std::cos(i * step), std::sin(i * step)) * radius, color));
+            vertices.append(sf::Vertex(center + sf::Vector2f(std::cos((i + 1) * step), std::sin((i + 1) * step)) * radius, color));
+        }
+    }
+
+    sf::Vector2f cellCenter(int row, int col) const {
+        return sf::Vector2f(GRID_OFFSET_X + (col + 0.5f) * CELL_SIZE,
+                            GRID_OFFSET_Y + (row + 0.5f) * CELL_SIZE);
+    }
+
+    sf::Color discColor(Player player) const {
+        return player == Player::One ? sf::Color::Red : sf::Color::Yellow;
+    }
+
     void setupButtons() {
-        // Only continue button needed
+        setupButton(pvpButton, "Player vs Player",
+                   sf::Vector2f((window.getSize().x - 300) / 2, 200),
+                   sf::Vector2f(300, 50));
+        setupButton(pvcButton, "Player vs Computer",
+                   sf::Vector2f((window.getSize().x - 300) / 2, 300),
+                   sf::Vector2f(300, 50));
+        setupButton(mctsButton, "Player vs Monte Carlo",
+                   sf::Vector2f((window.getSize().x - 300) / 2, 400),
+                   sf::Vector2f(300, 50));
+
         setupButton(continueButton, "Continue",
                    sf::Vector2f((window.getSize().x - 200) / 2, window.getSize().y - 100),
                    sf::Vector2f(200, 50));
@@ -123,6 +240,17 @@ private:
         scoreText.setFillColor(sf::Color::White);
         scoreText.setPosition(20, 60);
 
+        analysisHint.setFont(font);
+        analysisHint.setCharacterSize(18);
+        analysisHint.setFillColor(sf::Color(180, 180, 180));
+        analysisHint.setString("A: analysis");
+        analysisHint.setPosition(window.getSize().x - analysisHint.getGlobalBounds().width - 20, 20);
+
+        for (auto& text : analysisTexts) {
+            text.setFont(font);
+            text.setCharacterSize(16);
+        }
+
         updateStatusText();
         updateScoreText();
     }
@@ -133,11 +261,17 @@ private:
         }
         currentPlayer = Player::One;
         droppingDisc.reset();
+        discVertices.clear();
+        placedVertexCount = 0;
+        position = Position();
+        computer.newGame(gameMode == GameMode::PvMCTS ? Computer::Engine::MonteCarlo
+                                                      : Computer::Engine::Negamax);
+        restartAnalysis();
     }
 
     void handleEvents() {
         sf::Event event;
-        while (window.pollEvent(event)) {
+        while (pacer.pollEvent(event)) {
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
@@ -150,14 +284,29 @@ private:
             else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) {
                 shouldExit = true;
             }
+            else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::A) {
+                analysisEnabled = !analysisEnabled;
+                restartAnalysis();
+            }
         }
     }
 
     void handleMouseClick(const sf::Event::MouseButtonEvent& mouseButton) {
         sf::Vector2f mousePos(mouseButton.x, mouseButton.y);
 
-        if (currentState == GameState::Playing) {
-            if (!droppingDisc) {  // Only allow new moves if no animation is playing
+        if (currentState == GameState::SelectMode) {
+            if (checkButtonClick(mousePos, pvpButton)) {
+                startGame(GameMode::PvP);
+            }
+            else if (checkButtonClick(mousePos, pvcButton)) {
+                startGame(GameMode::PvC);
+            }
+            else if (checkButtonClick(mousePos, mctsButton)) {
+                startGame(GameMode::PvMCTS);
+            }
+        }
+        else if (currentState == GameState::Playing) {
+            if (!droppingDisc && !isComputerTurn()) {  // Only allow new moves if no animation is playing
                 int col = getColumnFromX(mousePos.x);
                 if (col >= 0 && col < COLS && !isColumnFull(col)) {
                     makeMove(col);
@@ -171,34 +320,77 @@ private:
         }
     }
 
+    void startGame(GameMode mode) {
+        gameMode = mode;
+        currentState = GameState::Playing;
+        resetGrid();
+        updateStatusText();
+        updateScoreText();
+    }
+
+    bool isComputerTurn() const {
+        return gameMode != GameMode::PvP && currentPlayer == Player::Two;
+    }
+
+    // Whether the next frame can differ from this one without any input: a disc is falling,
+    // or the computer or the analysis overlay is still searching
+    bool isAnimating() const {
+        return droppingDisc || (currentState == GameState::Playing &&
+                                (isComputerTurn() || (analysisEnabled && !analysisFinished)));
+    }
+
     void makeMove(int col) {
         int row = getLowestEmptyRow(col);
         if (row >= 0) {
-            // Start dropping animation
+            // Start dropping animation from above the grid, bouncing on landing
+            float startY = GRID_OFFSET_Y - CELL_SIZE;
+            float targetY = GRID_OFFSET_Y + row * CELL_SIZE;
+            float duration = DROP_TIME_PER_SQRT_CELL * std::sqrt(float(row + 1));
             droppingDisc = DroppingDisc{
                 col,
-                GRID_OFFSET_Y - CELL_SIZE,  // Start above grid
-                GRID_OFFSET_Y + row * CELL_SIZE,  // Target position
+                Tween(startY, targetY, duration, Easing::easeOutBounce),
                 currentPlayer
             };
+
+            // Let the computer search while the disc is still falling
+            if (gameMode != GameMode::PvP && !position.isWinningMove(col)) {
+                Position next(position);
+                next.play(col);
+                if (currentPlayer == Player::Two) {
+                    computer.ponder(next);
+                } else {
+                    computer.requestMove(next);
+                }
+            }
         }
     }
 
-    void updateGame() {
+    void updateGame(float deltaTime) {
+        if (currentState == GameState::Playing && !droppingDisc && isComputerTurn()) {
+            int col = computer.takeMove(position);
+            if (col >= 0) {
+                makeMove(col);
+            }
+        }
+
         if (droppingDisc) {
             // Update dropping animation
-            const float DROP_SPEED = 500.0f;
-            float deltaTime = 1.0f / 60.0f;
+            droppingDisc->fall.update(deltaTime);
 
-            droppingDisc->currentY += DROP_SPEED * deltaTime;
+            // Only the falling disc's vertices change while it moves
+            discVertices.resize(placedVertexCount);
 
-            if (droppingDisc->currentY >= droppingDisc->targetY) {
+            if (droppingDisc->fall.isFinished()) {
                 // Animation complete, place disc
                 int row = getLowestEmptyRow(droppingDisc->col);
+                bool isWin = position.isWinningMove(droppingDisc->col);
                 grid[row][droppingDisc->col] = droppingDisc->player;
+                position.play(droppingDisc->col);
+                appendDisc(discVertices, cellCenter(row, droppingDisc->col), discColor(droppingDisc->player));
+                placedVertexCount = discVertices.getVertexCount();
 
                 // Check for win
-                if (checkWin(row, droppingDisc->col)) {
+                if (isWin) {
                     handleWin();
                 }
                 else if (isBoardFull()) {
@@ -211,23 +403,104 @@ private:
                 }
 
                 droppingDisc.reset();
+                restartAnalysis();
+            }
+            else {
+                appendDisc(discVertices,
+                           sf::Vector2f(GRID_OFFSET_X + (droppingDisc->col + 0.5f) * CELL_SIZE,
+                                        droppingDisc->fall.value() + CELL_SIZE / 2),
+                           discColor(droppingDisc->player));
             }
         }
+
+        if (analysisEnabled) {
+            updateAnalysisTexts();
+        }
+    }
+
+    // The search restarts on every new position and only runs while the overlay is shown
+    void restartAnalysis() {
+        if (analysisEnabled && currentState == GameState::Playing) {
+            analyzer.analyze(position);
+        } else {
+            analyzer.stop();
+        }
+    }
+
+    // Rebuilds the labels only when the background search has published something new
+    void updateAnalysisTexts() {
+        typename Analyzer::Snapshot snapshot = analyzer.getSnapshot();
+        analysisFinished = snapshot.finished;
+        if (snapshot.version == shownAnalysisVersion) {
+            return;
+        }
+        shownAnalysisVersion = snapshot.version;
+
+        for (int col = 0; col < COLS; col++) {
+            const auto& result = snapshot.columns[col];
+            sf::Text& text = analysisTexts[col];
+            if (!result.playable) {
+                text.setString("");
+                continue;
+            }
+
+            if (!result.exact) {
+                text.setString("?");
+                text.setFillColor(sf::Color(150, 150, 150));
+            } else if (result.score == 0) {
+                text.setString("Draw");
+                text.setFillColor(sf::Color::White);
+            } else {
+                int moves = Solver::movesToResult(result.score, snapshot.nbMoves);
+                text.setString((result.score > 0 ? "W" : "L") + std::to_string(moves));
+                text.setFillColor(result.score > 0 ? sf::Color::Green : sf::Color::Red);
+            }
+            text.setPosition(
+                GRID_OFFSET_X + (col + 0.5f) * CELL_SIZE - text.getGlobalBounds().width / 2,
+                GRID_OFFSET_Y - 22
+            );
+        }
     }
 
     void handleWin() {
         currentState = GameState::GameOver;
         if (currentPlayer == Player::One) {
             player1Score++;
+            if (gameMode != GameMode::PvP) {
+                recordWin();
+            }
         } else {
             player2Score++;
+            if (gameMode != GameMode::PvP) {
+                PlayerProfiles::standard().recordGame(gameTitle(), opponentDifficulty(), GameResult::Loss);
+            }
         }
         updateScoreText();
         updateStatusText();
     }
 
+    // Wins against the computer score like the solver does: faster wins score higher
+    void recordWin() {
+        int score = (COLS * ROWS + 1 - (position.nbMoves() - 1)) / 2;
+        PlayerProfiles& profiles = PlayerProfiles::standard();
+        HighScoreManager::standard().addScore(gameTitle(), profiles.getCurrentPlayer(), score,
+                                              std::string(ScoreEntry::difficultyName(opponentDifficulty())), false);
+        profiles.recordGame(gameTitle(), opponentDifficulty(), GameResult::Win, score);
+    }
+
+    static std::string gameTitle() {
+        return "Connect Four " + std::to_string(COLS) + "x" + std::to_string(ROWS);
+    }
+
+    ScoreDifficulty opponentDifficulty() const {
+        return gameMode == GameMode::PvMCTS ? ScoreDifficulty::MonteCarlo : ScoreDifficulty::Negamax;
+    }
+
     void handleDraw() {
         currentState = GameState::GameOver;
+        if (gameMode != GameMode::PvP) {
+            PlayerProfiles::standard().recordGame(gameTitle(), opponentDifficulty(), GameResult::Draw);
+        }
         updateStatusText();
     }
 
@@ -235,6 +508,9 @@ private:
         window.clear(sf::Color(50, 50, 50));
 
         switch (currentState) {
+            case GameState::SelectMode:
+                renderModeSelection();
+                break;
             case GameState::Playing:
             case GameState::GameOver:
                 renderGame();
@@ -244,49 +520,33 @@ private:
         window.display();
     }
 
+    void renderModeSelection() {
+        window.draw(pvpButton.shape);
+        window.draw(pvpButton.text);
+        window.draw(pvcButton.shape);
+        window.draw(pvcButton.text);
+        window.draw(mctsButton.shape);
+        window.draw(mctsButton.text);
+    }
+
     void renderGame() {
         // Draw status and score
         window.draw(statusText);
         window.draw(scoreText);
 
-        // Draw grid
-        for (int row = 0; row < ROWS; row++) {
-            for (int col = 0; col < COLS; col++) {
-                sf::CircleShape cell(CELL_SIZE / 2 - 2);
-                cell.setPosition(
-                    GRID_OFFSET_X + col * CELL_SIZE + 2,
-                    GRID_OFFSET_Y + row * CELL_SIZE + 2
-                );
-
-                // Set color based on player
-                switch (grid[row][col]) {
-                    case Player::One:
-                        cell.setFillColor(sf::Color::Red);
-                        break;
-                    case Player::Two:
-                        cell.setFillColor(sf::Color::Yellow);
-                        break;
-                    default:
-                        cell.setFillColor(sf::Color::White);
-                        break;
-                }
+        // Cached empty board, then every disc in a single draw call
+        window.draw(boardSprite);
+        window.draw(discVertices);
 
-                window.draw(cell);
+        if (currentState == GameState::Playing) {
+            window.draw(analysisHint);
+            if (analysisEnabled) {
+                for (const auto& text : analysisTexts) {
+                    window.draw(text);
+                }
             }
         }
 
-        // Draw dropping disc animation
-        if (droppingDisc) {
-            sf::CircleShape disc(CELL_SIZE / 2 - 2);
-            disc.setPosition(
-                GRID_OFFSET_X + droppingDisc->col * CELL_SIZE + 2,
-                droppingDisc->currentY + 2
-            );
-            disc.setFillColor(droppingDisc->player == Player::One ? 
-                             sf::Color::Red : sf::Color::Yellow);
-            window.draw(disc);
-        }
-
         // Draw continue button in game over state
         if (currentState == GameState::GameOver) {
             window.draw(continueButton.shape);
@@ -322,31 +582,41 @@ private:
         return col;
     }
 
+    std::string playerName(Player player) const {
+        if (player == Player::One) return "Player 1";
+        return gameMode == GameMode::PvP ? "Player 2" : "Computer";
+    }
+
     void updateStatusText() {
         if (currentState == GameState::GameOver) {
             if (isBoardFull()) {
                 statusText.setString("Game Over - Draw!");
             } else {
-                std::string winner = (currentPlayer == Player::One) ? "Player 1" : "Player 2";
-                statusText.setString(winner + " Wins!");
+                statusText.setString(playerName(currentPlayer) + " Wins!");
             }
+        } else if (isComputerTurn()) {
+            statusText.setString("Computer is thinking...");
         } else {
-            std::string currentPlayerStr = (currentPlayer == Player::One) ? "Player 1" : "Player 2";
-            statusText.setString(currentPlayerStr + "'s Turn");
+            statusText.setString(playerName(currentPlayer) + "'s Turn");
         }
     }
 
     void updateScoreText() {
         scoreText.setString(
-            "Player 1: " + std::to_string(player1Score) + " - " +
-            "Player 2: " + std::to_string(player2Score)
+            playerName(Player::One) + ": " + std::to_string(player1Score) + " - " +
+            playerName(Player::Two) + ": " + std::to_string(player2Score)
         );
     }
 
     void handleMouseMove(const sf::Event::MouseMoveEvent& mouseMove) {
         sf::Vector2f mousePos(mouseMove.x, mouseMove.y);
         
-        if (currentState == GameState::GameOver) {
+        if (currentState == GameState::SelectMode) {
+            updateButtonHover(pvpButton, mousePos);
+            updateButtonHover(pvcButton, mousePos);
+            updateButtonHover(mctsButton, mousePos);
+        }
+        else if (currentState == GameState::GameOver) {
             updateButtonHover(continueButton, mousePos);
         }
     }
@@ -372,55 +642,28 @@ private:
     bool checkButtonClick(const sf::Vector2f& mousePos, const Button& button) {
         return button.shape.getGlobalBounds().contains(mousePos);
     }
+};
 
-    bool checkWin(int row, int col) {
-        // Check horizontal
-        int count = 0;
-        for (int c = 0; c < COLS; c++) {
-            if (grid[row][c] == currentPlayer) {
-                count++;
-                if (count == 4) return true;
-            } else {
-                count = 0;
-            }
-        }
-
-        // Check vertical
-        count = 0;
-        for (int r = 0; r < ROWS; r++) {
-            if (grid[r][col] == currentPlayer) {
-                count++;
-                if (count == 4) return true;
-            } else {
-                count = 0;
-            }
-        }
-
-        // Check diagonal (both directions)
-        for (int r = 0; r < ROWS - 3; r++) {
-            for (int c = 0; c < COLS - 3; c++) {
-                if (grid[r][c] == currentPlayer &&
-                    grid[r+1][c+1] == currentPlayer &&
-                    grid[r+2][c+2] == currentPlayer &&
-                    grid[r+3][c+3] == currentPlayer) {
-                    return true;
-                }
-            }
-        }
+using ConnectFour = BasicConnectFour<>;
 
-        for (int r = 3; r < ROWS; r++) {
-            for (int c = 0; c < COLS - 3; c++) {
-                if (grid[r][c] == currentPlayer &&
-                    grid[r-1][c+1] == currentPlayer &&
-                    grid[r-2][c+2] == currentPlayer &&
-                    grid[r-3][c+3] == currentPlayer) {
-                    return true;
-                }
-            }
-        }
-
-        return false;
+// Board size selection; each variant is its own template instantiation
+class ConnectFourLauncher : public VariantLauncher {
+private:
+    template <int ROWS, int COLS>
+    static bool runVariant(sf::RenderWindow& window, sf::Font& font) {
+        BasicConnectFour<ROWS, COLS> game(window, font);
+        return game.run();
     }
+
+public:
+    ConnectFourLauncher(sf::RenderWindow& gameWindow, sf::Font& gameFont)
+        : VariantLauncher(gameWindow, gameFont, "Select Board Size", 250, {
+              {"7 x 6 (Classic)", &runVariant<6, 7>},
+              {"8 x 7", &runVariant<7, 8>},
+              {"9 x 7", &runVariant<7, 9>},
+              {"9 x 9", &runVariant<9, 9>},
+              {"10 x 10", &runVariant<10, 10>}
+          }) {}
 };
 
 // // Define static constants
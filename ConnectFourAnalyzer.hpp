@@ -0,0 +1,178 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "ConnectFourSolver.hpp"
+#include "ConnectFourTablebase.hpp"
+
+// Evaluates every column of a position on a background thread.
+// The search deepens two plies at a time and publishes each column as soon as it is
+// searched, so the UI can poll a snapshot every frame without ever waiting on the engine.
+// Calling analyze() again aborts the current search and restarts on the new position.
+template <int WIDTH, int HEIGHT>
+class BasicConnectFourAnalyzer {
+public:
+    using Position = BasicConnectFourPosition<WIDTH, HEIGHT>;
+    using Solver = BasicConnectFourSolver<WIDTH, HEIGHT>;
+
+    struct ColumnResult {
+        bool playable;
+        bool exact;   // Proven result; otherwise only searched to `depth` plies
+        int score;    // From the point of view of the player to move
+        int depth;
+    };
+
+    struct Snapshot {
+        std::array<ColumnResult, WIDTH> columns;
+        int nbMoves;
+        unsigned version;  // Changes whenever any column is updated
+        bool finished;
+    };
+
+private:
+    Solver solver;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::atomic<bool> abortSearch;
+
+    // Guarded by mutex
+    bool stopping;
+    bool hasJob;
+    Position job;
+    Snapshot snapshot;
+
+public:
+    explicit BasicConnectFourAnalyzer(unsigned tableLogSize = 21)
+        : solver(tableLogSize), abortSearch(false), stopping(false), hasJob(false) {
+        snapshot.version = 0;
+        clearSnapshot(Position());
+        solver.setAbortFlag(&abortSearch);
+        solver.setEndgameProbe(&BasicConnectFourTablebase<WIDTH, HEIGHT>::standard());
+        worker = std::thread(&BasicConnectFourAnalyzer::run, this);
+    }
+
+    ~BasicConnectFourAnalyzer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            abortSearch = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    BasicConnectFourAnalyzer(const BasicConnectFourAnalyzer&) = delete;
+    BasicConnectFourAnalyzer& operator=(const BasicConnectFourAnalyzer&) = delete;
+
+    void analyze(const Position& P) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = P;
+            hasJob = true;
+            abortSearch = true;
+            clearSnapshot(P);
+        }
+        wake.notify_one();
+    }
+
+    // Abandons the current search; the last snapshot stays readable
+    void stop() {
+        std::lock_guard<std::mutex> lock(mutex);
+        hasJob = false;
+        abortSearch = true;
+    }
+
+    Snapshot getSnapshot() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return snapshot;
+    }
+
+private:
+    void clearSnapshot(const Position& P) {
+        for (int col = 0; col < WIDTH; col++) {
+            snapshot.columns[col] = ColumnResult{P.canPlay(col), false, 0, 0};
+        }
+        snapshot.nbMoves = P.nbMoves();
+        snapshot.finished = false;
+        snapshot.version++;
+    }
+
+    void run() {
+        while (true) {
+            Position P;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return stopping || hasJob; });
+                if (stopping) {
+                    return;
+                }
+                P = job;
+                hasJob = false;
+                abortSearch = false;
+            }
+            search(P);
+        }
+    }
+
+    void search(const Position& P) {
+        solver.reset();
+
+        std::array<ColumnResult, WIDTH> columns;
+        for (int col = 0; col < WIDTH; col++) {
+            columns[col] = ColumnResult{P.canPlay(col), false, 0, 0};
+            if (columns[col].playable && P.isWinningMove(col)) {
+                columns[col].exact = true;
+                columns[col].score = (WIDTH * HEIGHT + 1 - P.nbMoves()) / 2;
+                if (!publish(col, columns[col], false)) {
+                    return;
+                }
+            }
+        }
+
+        for (int depth = 2; depth <= Solver::UNLIMITED_DEPTH; depth += 2) {
+            bool allExact = true;
+            for (int col = 0; col < WIDTH; col++) {
+                ColumnResult& result = columns[col];
+                if (!result.playable || result.exact) {
+                    continue;
+                }
+
+                Position P2(P);
+                P2.play(col);
+                int score = -solver.solveToDepth(P2, depth - 1);
+                if (solver.wasAborted()) {
+                    return;
+                }
+
+                result.score = score;
+                result.exact = solver.isExact();
+                result.depth = depth;
+                allExact = allExact && result.exact;
+                if (!publish(col, result, false)) {
+                    return;
+                }
+            }
+            if (allExact) {
+                break;
+            }
+        }
+        publish(-1, ColumnResult(), true);
+    }
+
+    // Returns false when a newer job has superseded this search
+    bool publish(int col, const ColumnResult& result, bool finished) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (hasJob || stopping || abortSearch) {
+            return false;
+        }
+        if (col >= 0) {
+            snapshot.columns[col] = result;
+        }
+        snapshot.finished = finished;
+        snapshot.version++;
+        return true;
+    }
+};
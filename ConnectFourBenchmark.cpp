@@ -0,0 +1,126 @@
+// Connect Four solver benchmark.
+// Solves sets of test positions with the same engine the game uses (ConnectFourSolver.hpp)
+// and reports mean time, nodes explored and nodes/sec per set.
+//
+// Build: g++ -O2 -std=c++17 ConnectFourBenchmark.cpp -o connect_four_bench
+// Usage: connect_four_bench [--weak] [set files...]
+//
+// Each line of a set file is "<move sequence> <expected score>", the move sequence being
+// 1-based column digits played from the empty board. Exits with 1 if any score differs.
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ConnectFourSolver.hpp"
+
+struct BenchmarkResult {
+    int positions = 0;
+    int mismatches = 0;
+    int invalid = 0;
+    double totalSeconds = 0.0;
+    unsigned long long totalNodes = 0;
+};
+
+static BenchmarkResult runSet(const std::string& path, ConnectFourSolver& solver, bool weak) {
+    BenchmarkResult result;
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Cannot open " << path << std::endl;
+        result.invalid = 1;
+        return result;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::istringstream fields(line);
+        std::string moves;
+        int expected;
+        if (!(fields >> moves >> expected)) {
+            continue;  // Blank or comment line
+        }
+
+        ConnectFourPosition position;
+        if (position.playSequence(moves) != moves.size()) {
+            std::cerr << path << ":" << lineNumber << ": invalid position " << moves << std::endl;
+            result.invalid++;
+            continue;
+        }
+        if (weak) {
+            expected = (expected > 0) - (expected < 0);
+        }
+
+        // Every position starts from a cold table so sets stay comparable
+        solver.reset();
+        auto start = std::chrono::steady_clock::now();
+        int score = solver.solve(position, weak);
+        auto end = std::chrono::steady_clock::now();
+
+        result.positions++;
+        result.totalSeconds += std::chrono::duration<double>(end - start).count();
+        result.totalNodes += solver.getNodeCount();
+        if (score != expected) {
+            std::cerr << path << ":" << lineNumber << ": " << moves
+                      << " expected " << expected << " got " << score << std::endl;
+            result.mismatches++;
+        }
+    }
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    bool weak = false;
+    std::vector<std::string> sets;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--weak") {
+            weak = true;
+        } else {
+            sets.push_back(arg);
+        }
+    }
+
+    // Increasing difficulty: end, middle and beginning of the game
+    if (sets.empty()) {
+        sets = {
+            "benchmarks/connect_four/end.txt",
+            "benchmarks/connect_four/middle.txt",
+            "benchmarks/connect_four/begin.txt"
+        };
+    }
+
+    ConnectFourSolver solver;
+    bool failed = false;
+
+    std::cout << std::left << std::setw(40) << "Set"
+              << std::right << std::setw(8) << "Count"
+              << std::setw(14) << "Mean time"
+              << std::setw(14) << "Mean nodes"
+              << std::setw(14) << "Knodes/s"
+              << std::setw(10) << "Errors" << std::endl;
+
+    for (const auto& set : sets) {
+        BenchmarkResult r = runSet(set, solver, weak);
+        failed = failed || r.mismatches > 0 || r.invalid > 0;
+        if (r.positions == 0) {
+            continue;
+        }
+
+        double meanMs = r.totalSeconds * 1000.0 / r.positions;
+        double meanNodes = double(r.totalNodes) / r.positions;
+        double knps = r.totalSeconds > 0 ? r.totalNodes / r.totalSeconds / 1000.0 : 0.0;
+
+        std::cout << std::left << std::setw(40) << set
+                  << std::right << std::setw(8) << r.positions
+                  << std::setw(11) << std::fixed << std::setprecision(3) << meanMs << " ms"
+                  << std::setw(14) << std::setprecision(0) << meanNodes
+                  << std::setw(14) << knps
+                  << std::setw(10) << (r.mismatches + r.invalid) << std::endl;
+    }
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,237 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "ConnectFourSolver.hpp"
+#include "ConnectFourTablebase.hpp"
+#include "ConnectFourMCTS.hpp"
+
+// Computer player that searches on a background thread and ponders on the opponent's time.
+// After its own move it predicts the human's reply and already searches its answer to it.
+// On a ponder hit the answer is either ready or the running search simply continues; on a
+// miss the ponder search is aborted and a fresh one starts. The transposition table is
+// kept for the whole game, so entries found while pondering are reused either way.
+// With the Monte Carlo engine, pondering grows the tree of the human's position instead;
+// the tree is re-rooted at the human's move, so every ponder playout is reused.
+template <int WIDTH, int HEIGHT>
+class BasicConnectFourComputer {
+public:
+    using Position = BasicConnectFourPosition<WIDTH, HEIGHT>;
+    using Solver = BasicConnectFourSolver<WIDTH, HEIGHT>;
+    using MCTS = BasicConnectFourMCTS<WIDTH, HEIGHT>;
+    using Bitboard = typename Position::Bitboard;
+
+    enum class Engine { Negamax, MonteCarlo };
+
+    struct Stats {
+        unsigned ponderHits;
+        unsigned ponderMisses;
+    };
+
+private:
+    enum class JobType { None, Think, Ponder };
+
+    static const unsigned long long PREDICTION_BUDGET = 100000;
+
+    Solver solver;
+    std::unique_ptr<MCTS> mcts;  // Created the first time a Monte Carlo game starts
+    const unsigned long long nodeBudget;
+    const unsigned mctsPlayouts;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::atomic<bool> abortSearch;
+
+    // Guarded by mutex
+    bool stopping;
+    bool resetRequested;
+    Engine engine;
+    bool pondering;         // A ponder was started and the human has not moved yet
+    JobType pendingType;
+    Position pendingPosition;
+    bool searching;
+    bool targetKnown;       // Position currently being searched is known
+    Bitboard searchKey;
+    bool resultReady;
+    Bitboard resultKey;
+    int resultColumn;
+    Stats stats;
+
+public:
+    BasicConnectFourComputer(unsigned long long budget, unsigned playouts, unsigned tableLogSize = 22)
+        : solver(tableLogSize), nodeBudget(budget), mctsPlayouts(playouts), abortSearch(false),
+          stopping(false), resetRequested(false), engine(Engine::Negamax), pondering(false), pendingType(JobType::None),
+          searching(false), targetKnown(false), searchKey(0),
+          resultReady(false), resultKey(0), resultColumn(-1), stats{0, 0} {
+        solver.setAbortFlag(&abortSearch);
+        solver.setEndgameProbe(&BasicConnectFourTablebase<WIDTH, HEIGHT>::standard());
+        worker = std::thread(&BasicConnectFourComputer::run, this);
+    }
+
+    ~BasicConnectFourComputer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            abortSearch = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    BasicConnectFourComputer(const BasicConnectFourComputer&) = delete;
+    BasicConnectFourComputer& operator=(const BasicConnectFourComputer&) = delete;
+
+    // Forget everything, including the transposition table and search trees (new game)
+    void newGame(Engine gameEngine = Engine::Negamax) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cancelLocked();
+        engine = gameEngine;
+        resetRequested = true;
+        pondering = false;
+        pendingType = JobType::None;
+        wake.notify_one();
+    }
+
+    // Start thinking on the opponent's time; P is the position with the human to move
+    void ponder(const Position& P) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cancelLocked();
+        pondering = (engine == Engine::Negamax);
+        pendingType = JobType::Ponder;
+        pendingPosition = P;
+        wake.notify_one();
+    }
+
+    // The human has moved; P is the position with the computer to move
+    void requestMove(const Position& P) {
+        std::lock_guard<std::mutex> lock(mutex);
+        bool hit = (resultReady && resultKey == P.key()) ||
+                   (searching && targetKnown && searchKey == P.key());
+        if (pondering) {
+            pondering = false;
+            if (hit) stats.ponderHits++;
+            else stats.ponderMisses++;
+        }
+        if (hit) {
+            return;  // Answer is ready or the running search is already on it
+        }
+        cancelLocked();
+        pendingType = JobType::Think;
+        pendingPosition = P;
+        wake.notify_one();
+    }
+
+    // Column to play in P once the search for it has finished
+    int takeMove(const Position& P) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (resultReady && resultKey == P.key()) {
+            resultReady = false;
+            return resultColumn;
+        }
+        return -1;
+    }
+
+    Stats getStats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+private:
+    void cancelLocked() {
+        abortSearch = true;
+        resultReady = false;
+        targetKnown = false;
+    }
+
+    void run() {
+        while (true) {
+            JobType type;
+            Engine jobEngine;
+            Position P;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] {
+                    return stopping || resetRequested || pendingType != JobType::None;
+                });
+                if (stopping) {
+                    return;
+                }
+                if (resetRequested) {
+                    resetRequested = false;
+                    lock.unlock();
+                    resetEngines();
+                    continue;
+                }
+                type = pendingType;
+                jobEngine = engine;
+                P = pendingPosition;
+                pendingType = JobType::None;
+                abortSearch = false;
+                searching = true;
+                targetKnown = (type == JobType::Think);
+                searchKey = P.key();
+            }
+
+            if (type == JobType::Ponder && jobEngine == Engine::MonteCarlo) {
+                mcts->search(P, mctsPlayouts);
+                finishSearch();
+                continue;
+            }
+            if (type == JobType::Ponder && !predictReply(P)) {
+                finishSearch();
+                continue;
+            }
+
+            int col = jobEngine == Engine::MonteCarlo ? mcts->chooseMove(P)
+                                                      : solver.chooseMove(P, nodeBudget);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            searching = false;
+            if (!abortSearch && col >= 0) {
+                resultReady = true;
+                resultKey = P.key();
+                resultColumn = col;
+            }
+        }
+    }
+
+    void resetEngines() {
+        solver.reset();
+        bool useMcts;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            useMcts = (engine == Engine::MonteCarlo);
+        }
+        if (useMcts) {
+            if (!mcts) {
+                mcts.reset(new MCTS(mctsPlayouts));
+                mcts->setAbortFlag(&abortSearch);
+            }
+            mcts->newGame();
+        }
+    }
+
+    // Plays the human's most likely reply into P and publishes the position searched next
+    bool predictReply(Position& P) {
+        int reply = solver.chooseMove(P, PREDICTION_BUDGET);
+        if (reply < 0 || P.isWinningMove(reply) || solver.wasAborted()) {
+            return false;
+        }
+        P.play(reply);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (abortSearch) {
+            return false;
+        }
+        targetKnown = true;
+        searchKey = P.key();
+        return true;
+    }
+
+    void finishSearch() {
+        std::lock_guard<std::mutex> lock(mutex);
+        searching = false;
+    }
+};
@@ -0,0 +1,364 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "ConnectFourSolver.hpp"
+
+// Monte Carlo Tree Search engine for Connect Four.
+// Each worker thread grows its own tree (root parallelization), so playouts run in parallel
+// without locks and the move is picked from the summed root visit counts. Nodes live in a
+// per-tree arena; when the game moves on, the subtree under the new root is copied into a
+// second arena and the two are swapped, so the search carries over between moves without
+// any per-node allocation.
+template <int WIDTH, int HEIGHT>
+class BasicConnectFourMCTS {
+public:
+    using Position = BasicConnectFourPosition<WIDTH, HEIGHT>;
+    using Bitboard = typename Position::Bitboard;
+
+private:
+    static constexpr float EXPLORATION = 1.4f;
+    static const uint32_t NO_NODE = 0;  // The root is never anybody's child
+
+    struct Node {
+        uint32_t firstChild;  // Children are allocated contiguously; NO_NODE until expanded
+        uint32_t visits;
+        float wins;           // From the point of view of the player who played `move`
+        int8_t move;
+        uint8_t childCount;
+        uint8_t terminal;     // 0 = ongoing, 1 = `move` won the game, 2 = board full
+    };
+
+    // Bump allocator over a fixed-capacity vector
+    class NodeArena {
+    private:
+        std::vector<Node> nodes;
+        size_t capacity;
+
+    public:
+        explicit NodeArena(size_t maxNodes) : capacity(maxNodes) {
+            nodes.reserve(maxNodes);
+        }
+
+        // Index of `count` consecutive nodes, or NO_NODE when the arena is full
+        uint32_t allocate(int count) {
+            if (nodes.size() + count > capacity) {
+                return NO_NODE;
+            }
+            uint32_t first = uint32_t(nodes.size());
+            nodes.resize(nodes.size() + count);
+            return first;
+        }
+
+        Node& operator[](uint32_t index) { return nodes[index]; }
+        const Node& operator[](uint32_t index) const { return nodes[index]; }
+
+        void clear() { nodes.clear(); }
+        size_t size() const { return nodes.size(); }
+
+        void swap(NodeArena& other) { nodes.swap(other.nodes); }
+    };
+
+    class Tree {
+    private:
+        NodeArena arena;
+        NodeArena spare;
+        Position rootPosition;
+        uint64_t rngState;
+
+    public:
+        Tree(size_t maxNodes, uint64_t seed)
+            : arena(maxNodes), spare(maxNodes), rngState(seed | 1) {
+            reset(Position());
+        }
+
+        void reset(const Position& P) {
+            arena.clear();
+            arena.allocate(1);
+            arena[0] = Node{NO_NODE, 0, 0.0f, -1, 0, 0};
+            rootPosition = P;
+        }
+
+        // Moves the root to P if it is the root, a child or a grandchild; otherwise starts over
+        void reroot(const Position& P) {
+            if (rootPosition.key() == P.key() && rootPosition.nbMoves() == P.nbMoves()) {
+                return;
+            }
+            const Node& root = arena[0];
+            for (uint32_t i = 0; i < root.childCount; i++) {
+                uint32_t child = root.firstChild + i;
+                Position Q(rootPosition);
+                Q.play(arena[child].move);
+                if (Q.key() == P.key()) {
+                    keepSubtree(child, Q);
+                    return;
+                }
+                const Node& childNode = arena[child];
+                for (uint32_t j = 0; j < childNode.childCount; j++) {
+                    uint32_t grandchild = childNode.firstChild + j;
+                    Position R(Q);
+                    R.play(arena[grandchild].move);
+                    if (R.key() == P.key()) {
+                        keepSubtree(grandchild, R);
+                        return;
+                    }
+                }
+            }
+            reset(P);
+        }
+
+        const Node& root() const { return arena[0]; }
+        const Node& node(uint32_t index) const { return arena[index]; }
+
+        void playout() {
+            uint32_t path[WIDTH * HEIGHT + 1];
+            int length = 0;
+            uint32_t current = 0;
+            Position P(rootPosition);
+            path[length++] = current;
+
+            // Selection and expansion
+            while (!arena[current].terminal) {
+                if (arena[current].firstChild == NO_NODE) {
+                    if ((arena[current].visits == 0 && current != 0) || !expand(current, P)) {
+                        break;
+                    }
+                }
+                current = selectChild(current);
+                P.play(arena[current].move);
+                path[length++] = current;
+            }
+
+            // Value for the player who made the last move on the path
+            const Node& leaf = arena[current];
+            float value;
+            if (leaf.terminal == 1) value = 1.0f;
+            else if (leaf.terminal == 2) value = 0.5f;
+            else value = 1.0f - rollout(P);
+
+            // Backpropagation, flipping perspective at every ply
+            for (int i = length - 1; i >= 0; i--) {
+                Node& n = arena[path[i]];
+                n.visits++;
+                n.wins += value;
+                value = 1.0f - value;
+            }
+        }
+
+    private:
+        uint64_t nextRandom() {
+            rngState ^= rngState << 13;
+            rngState ^= rngState >> 7;
+            rngState ^= rngState << 17;
+            return rngState;
+        }
+
+        // Returns false if the arena is full; an immediate win is the only child worth keeping
+        bool expand(uint32_t index, const Position& P) {
+            int moves[WIDTH];
+            int count = 0;
+            for (int col = 0; col < WIDTH; col++) {
+                if (P.canPlay(col)) {
+                    if (P.isWinningMove(col)) {
+                        moves[0] = col;
+                        count = 1;
+                        break;
+                    }
+                    moves[count++] = col;
+                }
+            }
+            if (count == 0) {
+                return false;
+            }
+
+            uint32_t first = arena.allocate(count);
+            if (first == NO_NODE) {
+                return false;
+            }
+            for (int i = 0; i < count; i++) {
+                uint8_t terminal = 0;
+                if (P.isWinningMove(moves[i])) terminal = 1;
+                else if (P.nbMoves() + 1 == WIDTH * HEIGHT) terminal = 2;
+                arena[first + i] = Node{NO_NODE, 0, 0.0f, int8_t(moves[i]), 0, terminal};
+            }
+            arena[index].firstChild = first;
+            arena[index].childCount = uint8_t(count);
+            return true;
+        }
+
+        // UCT, unvisited children first
+        uint32_t selectChild(uint32_t index) {
+            const Node& parent = arena[index];
+            float logVisits = std::log(float(parent.visits) + 1.0f);
+            uint32_t best = parent.firstChild;
+            float bestScore = -1.0f;
+            for (uint32_t i = 0; i < parent.childCount; i++) {
+                const Node& child = arena[parent.firstChild + i];
+                if (child.visits == 0) {
+                    return parent.firstChild + i;
+                }
+                float score = child.wins / child.visits +
+                              EXPLORATION * std::sqrt(logVisits / child.visits);
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = parent.firstChild + i;
+                }
+            }
+            return best;
+        }
+
+        // Random playout avoiding moves that lose on the spot.
+        // Returns 1 if the player to move in P wins, 0 if they lose, 0.5 for a draw.
+        float rollout(Position P) {
+            bool ourTurn = true;
+            while (true) {
+                if (P.nbMoves() >= WIDTH * HEIGHT) {
+                    return 0.5f;
+                }
+                if (P.canWinNext()) {
+                    return ourTurn ? 1.0f : 0.0f;
+                }
+                Bitboard next = P.possibleNonLosingMoves();
+                if (next == 0) {
+                    return ourTurn ? 0.0f : 1.0f;
+                }
+
+                int moves[WIDTH];
+                int count = 0;
+                for (int col = 0; col < WIDTH; col++) {
+                    if (next & Position::columnMask(col)) {
+                        moves[count++] = col;
+                    }
+                }
+                P.playMove(next & Position::columnMask(moves[nextRandom() % count]));
+                ourTurn = !ourTurn;
+            }
+        }
+
+        void keepSubtree(uint32_t newRoot, const Position& P) {
+            spare.clear();
+            spare.allocate(1);
+            spare[0] = arena[newRoot];
+
+            // Breadth-first copy; children stay contiguous in the new arena
+            for (uint32_t i = 0; i < spare.size(); i++) {
+                Node& copy = spare[i];
+                if (copy.firstChild == NO_NODE) {
+                    continue;
+                }
+                uint32_t oldFirst = copy.firstChild;
+                uint32_t newFirst = spare.allocate(copy.childCount);
+                if (newFirst == NO_NODE) {
+                    copy.firstChild = NO_NODE;
+                    copy.childCount = 0;
+                    continue;
+                }
+                for (uint32_t c = 0; c < copy.childCount; c++) {
+                    spare[newFirst + c] = arena[oldFirst + c];
+                }
+                spare[i].firstChild = newFirst;
+            }
+
+            arena.swap(spare);
+            rootPosition = P;
+        }
+    };
+
+    std::vector<std::unique_ptr<Tree>> trees;
+    unsigned playoutsPerMove;
+    const std::atomic<bool>* abortFlag;
+    unsigned long long playoutCount;
+
+public:
+    // threads = 0 uses every hardware thread; each gets a tree of at most nodesPerTree nodes
+    explicit BasicConnectFourMCTS(unsigned playouts = 200000, unsigned threads = 0,
+                                  size_t nodesPerTree = size_t(1) << 18)
+        : playoutsPerMove(playouts), abortFlag(nullptr), playoutCount(0) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (unsigned i = 0; i < threads; i++) {
+            trees.push_back(std::unique_ptr<Tree>(new Tree(nodesPerTree, 0x9E3779B97F4A7C15ull * (i + 1))));
+        }
+    }
+
+    void setPlayouts(unsigned playouts) { playoutsPerMove = playouts; }
+
+    void setAbortFlag(const std::atomic<bool>* flag) { abortFlag = flag; }
+
+    unsigned long long getPlayoutCount() const { return playoutCount; }
+
+    void newGame() {
+        for (auto& tree : trees) {
+            tree->reset(Position());
+        }
+    }
+
+    // Grows the trees rooted at P by `playouts` in total, split across threads
+    void search(const Position& P, unsigned playouts) {
+        for (auto& tree : trees) {
+            tree->reroot(P);
+        }
+
+        unsigned perTree = (playouts + trees.size() - 1) / trees.size();
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < trees.size(); i++) {
+            workers.emplace_back(&BasicConnectFourMCTS::runPlayouts, this, trees[i].get(), perTree);
+        }
+        runPlayouts(trees[0].get(), perTree);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        playoutCount += (unsigned long long)perTree * trees.size();
+    }
+
+    // Most visited column after topping the root up to the configured playout count
+    int chooseMove(const Position& P) {
+        for (int col = 0; col < WIDTH; col++) {
+            if (P.canPlay(col) && P.isWinningMove(col)) {
+                return col;
+            }
+        }
+
+        for (auto& tree : trees) {
+            tree->reroot(P);
+        }
+        unsigned long long existing = 0;
+        for (const auto& tree : trees) {
+            existing += tree->root().visits;
+        }
+        unsigned needed = existing < playoutsPerMove ? unsigned(playoutsPerMove - existing) : 0;
+        search(P, std::max(needed, unsigned(trees.size())));
+
+        unsigned long long visits[WIDTH] = {};
+        for (const auto& tree : trees) {
+            const Node& root = tree->root();
+            for (uint32_t i = 0; i < root.childCount; i++) {
+                const Node& child = tree->node(root.firstChild + i);
+                visits[child.move] += child.visits;
+            }
+        }
+
+        int best = -1;
+        for (int col = 0; col < WIDTH; col++) {
+            if (P.canPlay(col) && (best < 0 || visits[col] > visits[best])) {
+                best = col;
+            }
+        }
+        return best;
+    }
+
+private:
+    void runPlayouts(Tree* tree, unsigned count) {
+        for (unsigned i = 0; i < count; i++) {
+            if (abortFlag && abortFlag->load(std::memory_order_relaxed)) {
+                return;
+            }
+            tree->playout();
+        }
+    }
+};
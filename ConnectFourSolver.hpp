@@ -0,0 +1,496 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Smallest unsigned integer holding a (HEIGHT + 1) x WIDTH bitboard.
+// Boards above 64 bits (9x7, 9x9, 10x10...) use the GCC/Clang 128-bit integer.
+template <int WIDTH, int HEIGHT>
+using ConnectFourBitboard = typename std::conditional<
+    (HEIGHT + 1) * WIDTH <= 64, uint64_t, unsigned __int128>::type;
+
+// Bitboard Connect Four position (no SFML dependency, shared by the game and the benchmark).
+// Each column uses HEIGHT + 1 bits; the extra bit on top keeps keys unique and stops
+// shifts from bleeding into the neighbouring column.
+template <int WIDTH_, int HEIGHT_>
+class BasicConnectFourPosition {
+public:
+    static const int WIDTH = WIDTH_;
+    static const int HEIGHT = HEIGHT_;
+    static const int MIN_SCORE = -(WIDTH * HEIGHT) / 2 + 3;
+    static const int MAX_SCORE = (WIDTH * HEIGHT + 1) / 2 - 3;
+
+    using Bitboard = ConnectFourBitboard<WIDTH, HEIGHT>;
+
+    static_assert(WIDTH >= 4 && HEIGHT >= 4, "Board must fit an alignment of four");
+    static_assert((HEIGHT + 1) * WIDTH <= 128, "Board does not fit in a 128-bit bitboard");
+
+private:
+    Bitboard current;  // Stones of the player to move
+    Bitboard mask;     // All stones
+    int moves;
+
+public:
+    BasicConnectFourPosition() : current(0), mask(0), moves(0) {}
+
+    bool canPlay(int col) const {
+        return (mask & topMask(col)) == 0;
+    }
+
+    void play(int col) {
+        playMove((mask + bottomMask(col)) & columnMask(col));
+    }
+
+    void playMove(Bitboard move) {
+        current ^= mask;
+        mask |= move;
+        moves++;
+    }
+
+    // Plays a sequence of 1-based column digits ("4453...").
+    // Returns the number of moves applied; stops at the first invalid or winning move.
+    unsigned playSequence(const std::string& seq) {
+        for (unsigned i = 0; i < seq.size(); i++) {
+            int col = seq[i] - '1';
+            if (col < 0 || col >= WIDTH || !canPlay(col) || isWinningMove(col)) {
+                return i;
+            }
+            play(col);
+        }
+        return seq.size();
+    }
+
+    bool canWinNext() const {
+        return (winningPosition() & possible()) != 0;
+    }
+
+    bool isWinningMove(int col) const {
+        return (winningPosition() & possible() & columnMask(col)) != 0;
+    }
+
+    int nbMoves() const { return moves; }
+
+    Bitboard key() const { return current + mask; }
+
+    // Moves that do not hand the opponent an immediate win
+    Bitboard possibleNonLosingMoves() const {
+        Bitboard possibleMask = possible();
+        Bitboard opponentWin = opponentWinningPosition();
+        Bitboard forcedMoves = possibleMask & opponentWin;
+        if (forcedMoves) {
+            if (forcedMoves & (forcedMoves - 1)) {
+                return 0;  // Two threats at once, nothing saves the position
+            }
+            possibleMask = forcedMoves;
+        }
+        return possibleMask & ~(opponentWin >> 1);  // Never play right below an opponent threat
+    }
+
+    // Heuristic used for move ordering: number of open threats after the move
+    int moveScore(Bitboard move) const {
+        return popcount(computeWinningPosition(current | move, mask));
+    }
+
+    static Bitboard columnMask(int col) {
+        return ((Bitboard(1) << HEIGHT) - 1) << (col * (HEIGHT + 1));
+    }
+
+private:
+    Bitboard winningPosition() const {
+        return computeWinningPosition(current, mask);
+    }
+
+    Bitboard opponentWinningPosition() const {
+        return computeWinningPosition(current ^ mask, mask);
+    }
+
+    Bitboard possible() const {
+        return (mask + bottomMaskAll()) & boardMask();
+    }
+
+    static int popcount(Bitboard m) {
+        int c = 0;
+        for (; m; c++) {
+            m &= m - 1;
+        }
+        return c;
+    }
+
+    // Empty cells that would complete an alignment of four for the stones in `position`.
+    // Shift distances are compile-time constants, so each board size gets its own branch-free code.
+    static Bitboard computeWinningPosition(Bitboard position, Bitboard mask) {
+        // Vertical
+        Bitboard r = (position << 1) & (position << 2) & (position << 3);
+
+        // Horizontal
+        Bitboard p = (position << (HEIGHT + 1)) & (position << 2 * (HEIGHT + 1));
+        r |= p & (position << 3 * (HEIGHT + 1));
+        r |= p & (position >> (HEIGHT + 1));
+        p = (position >> (HEIGHT + 1)) & (position >> 2 * (HEIGHT + 1));
+        r |= p & (position << (HEIGHT + 1));
+        r |= p & (position >> 3 * (HEIGHT + 1));
+
+        // Diagonal 1
+        p = (position << HEIGHT) & (position << 2 * HEIGHT);
+        r |= p & (position << 3 * HEIGHT);
+        r |= p & (position >> HEIGHT);
+        p = (position >> HEIGHT) & (position >> 2 * HEIGHT);
+        r |= p & (position << HEIGHT);
+        r |= p & (position >> 3 * HEIGHT);
+
+        // Diagonal 2
+        p = (position << (HEIGHT + 2)) & (position << 2 * (HEIGHT + 2));
+        r |= p & (position << 3 * (HEIGHT + 2));
+        r |= p & (position >> (HEIGHT + 2));
+        p = (position >> (HEIGHT + 2)) & (position >> 2 * (HEIGHT + 2));
+        r |= p & (position << (HEIGHT + 2));
+        r |= p & (position >> 3 * (HEIGHT + 2));
+
+        return r & (boardMask() ^ mask);
+    }
+
+    static Bitboard bottomMask(int col) {
+        return Bitboard(1) << (col * (HEIGHT + 1));
+    }
+
+    static Bitboard topMask(int col) {
+        return (Bitboard(1) << (HEIGHT - 1)) << (col * (HEIGHT + 1));
+    }
+
+    static constexpr Bitboard bottomMaskAll() {
+        Bitboard m = 0;
+        for (int col = 0; col < WIDTH; col++) {
+            m |= Bitboard(1) << (col * (HEIGHT + 1));
+        }
+        return m;
+    }
+
+    static constexpr Bitboard boardMask() {
+        return bottomMaskAll() * ((Bitboard(1) << HEIGHT) - 1);
+    }
+};
+
+// Source of exact endgame scores the solver consults instead of searching (see ConnectFourTablebase.hpp)
+template <typename Bitboard>
+class ConnectFourEndgameProbe {
+public:
+    virtual ~ConnectFourEndgameProbe() {}
+
+    // Positions with at most this many empty cells may be probed; -1 if none
+    virtual int maxEmpty() const = 0;
+
+    virtual bool probe(Bitboard key, int& score) const = 0;
+};
+
+// Negamax solver with alpha-beta pruning, a transposition table and threat-based move ordering.
+// Scores follow the usual convention: positive if the player to move wins, larger the sooner
+// (a win with the player's last stone scores 1), 0 for a draw.
+template <int WIDTH_, int HEIGHT_>
+class BasicConnectFourSolver {
+public:
+    using Position = BasicConnectFourPosition<WIDTH_, HEIGHT_>;
+    using Bitboard = typename Position::Bitboard;
+
+    static const int WIDTH = Position::WIDTH;
+    static const int HEIGHT = Position::HEIGHT;
+    static const int UNLIMITED_DEPTH = WIDTH * HEIGHT;
+    static const int INVALID_MOVE = -1000;
+    static const unsigned long long NO_NODE_LIMIT = ~0ULL;
+
+private:
+    // Upper bounds keyed by the full position key, direct-mapped and always-replace
+    class TranspositionTable {
+    private:
+        std::vector<Bitboard> keys;
+        std::vector<uint8_t> values;
+
+    public:
+        explicit TranspositionTable(unsigned logSize)
+            : keys(size_t(1) << logSize), values(size_t(1) << logSize) {}
+
+        void reset() {
+            std::fill(keys.begin(), keys.end(), 0);
+            std::fill(values.begin(), values.end(), 0);
+        }
+
+        void put(Bitboard key, uint8_t value) {
+            size_t i = index(key);
+            keys[i] = key;
+            values[i] = value;
+        }
+
+        uint8_t get(Bitboard key) const {
+            size_t i = index(key);
+            return keys[i] == key ? values[i] : 0;
+        }
+
+    private:
+        size_t index(Bitboard key) const {
+            uint64_t folded = uint64_t(key);
+            if (sizeof(Bitboard) > sizeof(uint64_t)) {
+                folded ^= uint64_t(key >> 63 >> 1);
+            }
+            return size_t(folded ^ (folded >> 29)) & (keys.size() - 1);
+        }
+    };
+
+    // Fixed-capacity insertion sort, highest score comes out first
+    class MoveSorter {
+    private:
+        struct Entry { Bitboard move; int score; };
+        std::array<Entry, WIDTH> entries;
+        int size;
+
+    public:
+        MoveSorter() : size(0) {}
+
+        void add(Bitboard move, int score) {
+            int pos = size++;
+            for (; pos && entries[pos - 1].score > score; --pos) {
+                entries[pos] = entries[pos - 1];
+            }
+            entries[pos] = Entry{move, score};
+        }
+
+        Bitboard getNext() {
+            return size ? entries[--size].move : 0;
+        }
+    };
+
+    TranspositionTable table;
+    std::array<int, WIDTH> columnOrder;
+    unsigned long long nodeCount;
+    bool horizonReached;
+    const std::atomic<bool>* abortFlag;  // Optional, set by another thread to cut a search short
+    bool aborted;
+    unsigned long long nodeLimit;  // Searches unwind like aborted ones once nodeCount passes it
+    bool outOfBudget;
+    const ConnectFourEndgameProbe<Bitboard>* endgame;
+    int endgameMaxEmpty;
+
+public:
+    explicit BasicConnectFourSolver(unsigned tableLogSize = 22)
+        : table(tableLogSize), nodeCount(0), horizonReached(false),
+          abortFlag(nullptr), aborted(false), nodeLimit(NO_NODE_LIMIT), outOfBudget(false),
+          endgame(nullptr), endgameMaxEmpty(-1) {
+        // Explore center columns first
+        for (int i = 0; i < WIDTH; i++) {
+            columnOrder[i] = WIDTH / 2 + (1 - 2 * (i % 2)) * (i + 1) / 2;
+        }
+    }
+
+    void reset() {
+        nodeCount = 0;
+        table.reset();
+    }
+
+    unsigned long long getNodeCount() const { return nodeCount; }
+
+    // While the flag is set every search unwinds immediately; results are then meaningless
+    void setAbortFlag(const std::atomic<bool>* flag) { abortFlag = flag; }
+
+    bool wasAborted() const { return aborted; }
+
+    // Late positions covered by the probe return its exact score without being searched
+    void setEndgameProbe(const ConnectFourEndgameProbe<Bitboard>* probe) {
+        endgame = probe;
+        endgameMaxEmpty = probe ? probe->maxEmpty() : -1;
+    }
+
+    // Number of moves the winning side still has to play (including its winning move)
+    // for a score seen from the player to move after `nbMoves` moves; 0 for a draw
+    static int movesToResult(int score, int nbMoves) {
+        if (score == 0) return 0;
+        // The winner's final move is played when nbMoves reaches m, with (W*H + 1 - m) / 2 == |score|
+        int m = WIDTH * HEIGHT + 1 - 2 * std::abs(score);
+        int winnerParity = score > 0 ? nbMoves % 2 : (nbMoves + 1) % 2;
+        if (m % 2 != winnerParity) m--;
+        return (m - nbMoves - (score > 0 ? 0 : 1)) / 2 + 1;
+    }
+
+    // Exact score of the position (weak = only win/draw/loss sign)
+    int solve(const Position& P, bool weak = false) {
+        return solveToDepth(P, UNLIMITED_DEPTH, weak);
+    }
+
+    // Same null-window search, but stops `depth` plies down and treats the horizon as a draw.
+    // isExact() tells whether the last result was reached without touching the horizon.
+    int solveToDepth(const Position& P, int depth, bool weak = false) {
+        horizonReached = false;
+        aborted = false;
+        if (P.canWinNext()) {
+            return weak ? 1 : (WIDTH * HEIGHT + 1 - P.nbMoves()) / 2;
+        }
+
+        int min = -(WIDTH * HEIGHT - P.nbMoves()) / 2;
+        int max = (WIDTH * HEIGHT + 1 - P.nbMoves()) / 2;
+        if (weak) {
+            min = -1;
+            max = 1;
+        }
+
+        // Iteratively narrow the [min, max] window with null-window searches
+        while (min < max && !aborted) {
+            int med = min + (max - min) / 2;
+            if (med <= 0 && min / 2 < med) med = min / 2;
+            else if (med >= 0 && max / 2 > med) med = max / 2;
+
+            int r = negamax(P, med, med + 1, depth);
+            if (r <= med) max = r;
+            else min = r;
+        }
+        // Fail-high and fail-low results are exact bounds past the [-1, 1] window
+        return weak ? (min > 0) - (min < 0) : min;
+    }
+
+    bool isExact() const { return !horizonReached; }
+
+    // Score of every column from the point of view of the player to move
+    std::array<int, WIDTH> analyze(const Position& P, int depth = UNLIMITED_DEPTH, bool weak = false) {
+        std::array<int, WIDTH> scores;
+        scores.fill(INVALID_MOVE);
+        bool exact = true;
+        aborted = false;
+        for (int col = 0; col < WIDTH && !aborted; col++) {
+            if (!P.canPlay(col)) {
+                scores[col] = INVALID_MOVE;
+            }
+            else if (P.isWinningMove(col)) {
+                scores[col] = weak ? 1 : (WIDTH * HEIGHT + 1 - P.nbMoves()) / 2;
+            }
+            else {
+                Position P2(P);
+                P2.play(col);
+                scores[col] = -solveToDepth(P2, depth, weak);
+                exact = exact && isExact();
+            }
+        }
+        horizonReached = !exact;
+        return scores;
+    }
+
+    // Best column within a node budget: deepens until the result is exact or the budget runs out.
+    // The budget is checked inside the search, so an iteration running over it is cut short and
+    // the previous one's choice kept; the first, 2-ply iteration always completes.
+    int chooseMove(const Position& P, unsigned long long nodeBudget) {
+        int bestCol = -1;
+        unsigned long long start = nodeCount;
+        outOfBudget = false;
+        for (int depth = 2; depth <= UNLIMITED_DEPTH; depth += 2) {
+            std::array<int, WIDTH> scores = analyze(P, depth);
+            if (aborted) {
+                break;  // Keep the previous iteration's choice
+            }
+            bestCol = bestColumn(scores);
+            if (isExact() || nodeCount - start >= nodeBudget) {
+                break;
+            }
+            nodeLimit = start + nodeBudget;
+        }
+        nodeLimit = NO_NODE_LIMIT;
+        if (outOfBudget) {
+            aborted = false;  // Running out of budget is not an abort
+        }
+        return bestCol;
+    }
+
+    // Highest-scoring playable column, ties broken toward the center
+    int bestColumn(const std::array<int, WIDTH>& scores) const {
+        int best = -1;
+        for (int col : columnOrder) {
+            if (scores[col] != INVALID_MOVE && (best < 0 || scores[col] > scores[best])) {
+                best = col;
+            }
+        }
+        return best;
+    }
+
+private:
+    int negamax(const Position& P, int alpha, int beta, int depth) {
+        nodeCount++;
+
+        if (abortFlag && abortFlag->load(std::memory_order_relaxed)) {
+            aborted = true;
+            horizonReached = true;  // Keeps partial results out of the table
+            return alpha;
+        }
+        if (nodeCount > nodeLimit) {
+            outOfBudget = true;
+            aborted = true;
+            horizonReached = true;
+            return alpha;
+        }
+
+        Bitboard next = P.possibleNonLosingMoves();
+        if (next == 0) {
+            return -(WIDTH * HEIGHT - P.nbMoves()) / 2;  // Opponent wins next move
+        }
+        if (P.nbMoves() >= WIDTH * HEIGHT - 2) {
+            return 0;  // Draw, neither player can win anymore
+        }
+
+        if (WIDTH * HEIGHT - P.nbMoves() <= endgameMaxEmpty) {
+            int score;
+            if (endgame->probe(P.key(), score)) {
+                return score;
+            }
+        }
+
+        int min = -(WIDTH * HEIGHT - 2 - P.nbMoves()) / 2;
+        if (alpha < min) {
+            alpha = min;
+            if (alpha >= beta) return alpha;
+        }
+
+        int max = (WIDTH * HEIGHT - 1 - P.nbMoves()) / 2;
+        if (uint8_t val = table.get(P.key())) {
+            max = val + Position::MIN_SCORE - 1;
+        }
+        if (beta > max) {
+            beta = max;
+            if (alpha >= beta) return beta;
+        }
+
+        if (depth <= 0) {
+            horizonReached = true;
+            return alpha > 0 ? alpha : (beta < 0 ? beta : 0);
+        }
+
+        MoveSorter moves;
+        for (int i = WIDTH - 1; i >= 0; i--) {
+            if (Bitboard move = next & Position::columnMask(columnOrder[i])) {
+                moves.add(move, P.moveScore(move));
+            }
+        }
+
+        // Only bounds computed without reaching the horizon are safe to reuse
+        bool outerHorizon = horizonReached;
+        horizonReached = false;
+
+        while (Bitboard move = moves.getNext()) {
+            Position P2(P);
+            P2.playMove(move);
+            int score = -negamax(P2, -beta, -alpha, depth - 1);
+            if (score >= beta) {
+                horizonReached |= outerHorizon;
+                return score;
+            }
+            if (score > alpha) alpha = score;
+        }
+
+        if (!horizonReached) {
+            table.put(P.key(), uint8_t(alpha - Position::MIN_SCORE + 1));
+        }
+        horizonReached |= outerHorizon;
+        return alpha;
+    }
+};
+
+// Standard 7 columns x 6 rows game
+using ConnectFourPosition = BasicConnectFourPosition<7, 6>;
+using ConnectFourSolver = BasicConnectFourSolver<7, 6>;
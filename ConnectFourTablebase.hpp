@@ -0,0 +1,139 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ConnectFourSolver.hpp"
+#include "MappedFile.hpp"
+
+// Endgame tablebase: exact scores of late positions, produced offline by
+// ConnectFourTablebaseGen.cpp and memory-mapped at runtime.
+//
+// File layout (native endianness):
+//   Header
+//   keys[count]    position keys (Position::key()), ascending
+//   scores[count]  int8 score from the point of view of the player to move
+// Probing is a binary search over the mapped keys, so nothing is loaded or parsed up front.
+template <int WIDTH, int HEIGHT>
+class BasicConnectFourTablebase : public ConnectFourEndgameProbe<ConnectFourBitboard<WIDTH, HEIGHT>> {
+public:
+    using Bitboard = ConnectFourBitboard<WIDTH, HEIGHT>;
+    using Entry = std::pair<Bitboard, int8_t>;
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t width;
+        uint32_t height;
+        uint32_t maxEmpty;
+        uint32_t keyBytes;
+        uint64_t count;
+    };
+
+    static const uint32_t VERSION = 1;
+
+private:
+    MappedFile file;
+    const Header* header;
+    const Bitboard* keys;
+    const int8_t* scores;
+
+public:
+    BasicConnectFourTablebase() : header(nullptr), keys(nullptr), scores(nullptr) {}
+
+    explicit BasicConnectFourTablebase(const std::string& path)
+        : header(nullptr), keys(nullptr), scores(nullptr) {
+        open(path);
+    }
+
+    // The default file next to the executable, opened once and shared by every solver
+    static const BasicConnectFourTablebase& standard() {
+        static BasicConnectFourTablebase tablebase(defaultPath());
+        return tablebase;
+    }
+
+    static std::string defaultPath() {
+        return "connect_four_" + std::to_string(WIDTH) + "x" + std::to_string(HEIGHT) + ".c4tb";
+    }
+
+    bool open(const std::string& path) {
+        header = nullptr;
+        if (!file.open(path) || file.size() < sizeof(Header)) {
+            file.close();
+            return false;
+        }
+
+        const Header* h = reinterpret_cast<const Header*>(file.data());
+        bool valid = std::memcmp(h->magic, "C4TB", 4) == 0 &&
+                     h->version == VERSION &&
+                     h->width == uint32_t(WIDTH) && h->height == uint32_t(HEIGHT) &&
+                     h->keyBytes == sizeof(Bitboard) &&
+                     file.size() == sizeof(Header) + h->count * (sizeof(Bitboard) + 1);
+        if (!valid) {
+            file.close();
+            return false;
+        }
+
+        header = h;
+        keys = reinterpret_cast<const Bitboard*>(file.data() + sizeof(Header));
+        scores = reinterpret_cast<const int8_t*>(file.data() + sizeof(Header) + h->count * sizeof(Bitboard));
+        return true;
+    }
+
+    bool isOpen() const { return header != nullptr; }
+
+    uint64_t size() const { return header ? header->count : 0; }
+
+    int maxEmpty() const override {
+        return header ? int(header->maxEmpty) : -1;
+    }
+
+    bool probe(Bitboard key, int& score) const override {
+        if (!header) {
+            return false;
+        }
+        const Bitboard* end = keys + header->count;
+        const Bitboard* it = std::lower_bound(keys, end, key);
+        if (it == end || *it != key) {
+            return false;
+        }
+        score = scores[it - keys];
+        return true;
+    }
+
+    // Sorts the entries and writes a complete tablebase file
+    static bool write(const std::string& path, int maxEmpty, std::vector<Entry>& entries) {
+        std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) {
+                return a.first < b.first;
+            });
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+
+        Header h;
+        std::memcpy(h.magic, "C4TB", 4);
+        h.version = VERSION;
+        h.width = WIDTH;
+        h.height = HEIGHT;
+        h.maxEmpty = uint32_t(maxEmpty);
+        h.keyBytes = sizeof(Bitboard);
+        h.count = entries.size();
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+
+        for (const auto& entry : entries) {
+            out.write(reinterpret_cast<const char*>(&entry.first), sizeof(Bitboard));
+        }
+        for (const auto& entry : entries) {
+            out.put(char(entry.second));
+        }
+        return bool(out);
+    }
+};
+
+using ConnectFourTablebase = BasicConnectFourTablebase<7, 6>;
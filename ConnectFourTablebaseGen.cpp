@@ -0,0 +1,237 @@
+// Connect Four endgame tablebase generator.
+// Collects every position with at most N empty cells reachable from a set of seed games,
+// then solves them by retrograde analysis: layer by layer from the full board upwards,
+// each position's score comes straight from the already-solved positions one move later.
+//
+// Build: g++ -O2 -std=c++17 ConnectFourTablebaseGen.cpp -o connect_four_tbgen
+// Usage: connect_four_tbgen [--size 7x6|8x7|9x7|9x9|10x10] [--empty N] [--random GAMES]
+//                           [--output FILE] [seed files...]
+//
+// Seed files hold one move sequence per line (1-based column digits, anything after the
+// first space is ignored, so benchmark sets work as seeds). Without seed files, GAMES random
+// games are used. The default output is the file the game loads (connect_four_7x6.c4tb).
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ConnectFourTablebase.hpp"
+
+struct GeneratorOptions {
+    std::string size = "7x6";
+    int maxEmpty = 12;
+    int randomGames = 2000;
+    std::string output;
+    std::vector<std::string> seedFiles;
+};
+
+template <typename Bitboard>
+struct KeyHash {
+    size_t operator()(Bitboard key) const {
+        uint64_t folded = uint64_t(key);
+        if (sizeof(Bitboard) > sizeof(uint64_t)) {
+            folded ^= uint64_t(key >> 63 >> 1) * 0x9E3779B97F4A7C15ull;
+        }
+        return size_t(folded ^ (folded >> 31));
+    }
+};
+
+template <int WIDTH, int HEIGHT>
+class TablebaseGenerator {
+private:
+    using Position = BasicConnectFourPosition<WIDTH, HEIGHT>;
+    using Tablebase = BasicConnectFourTablebase<WIDTH, HEIGHT>;
+    using Bitboard = typename Position::Bitboard;
+
+    const int maxEmpty;
+    // Per number of empty cells: the positions, and their scores once solved
+    std::vector<std::vector<Position>> positions;
+    std::vector<std::unordered_map<Bitboard, int8_t, KeyHash<Bitboard>>> scores;
+
+public:
+    explicit TablebaseGenerator(int empty)
+        : maxEmpty(std::min(empty, WIDTH * HEIGHT)), positions(maxEmpty + 1), scores(maxEmpty + 1) {}
+
+    // Plays the seed until at most maxEmpty cells are left; games that end earlier are skipped
+    void addSeed(const std::string& moves) {
+        Position P;
+        for (char c : moves) {
+            if (emptyCells(P) <= maxEmpty) {
+                break;
+            }
+            int col = c - '1';
+            if (col < 0 || col >= WIDTH || !P.canPlay(col) || P.isWinningMove(col)) {
+                return;
+            }
+            P.play(col);
+        }
+        if (emptyCells(P) <= maxEmpty) {
+            insert(P);
+        }
+    }
+
+    void addRandomSeeds(int games, unsigned seed) {
+        std::mt19937 gen(seed);
+        for (int i = 0; i < games; i++) {
+            Position P;
+            bool finished = false;
+            while (emptyCells(P) > maxEmpty && !finished) {
+                int col = gen() % WIDTH;
+                if (!P.canPlay(col)) {
+                    continue;
+                }
+                finished = P.isWinningMove(col);
+                P.play(col);
+            }
+            if (!finished) {
+                insert(P);
+            }
+        }
+    }
+
+    // Forward pass: every non-terminal successor, down to the full board
+    void expand() {
+        for (int e = maxEmpty; e > 0; e--) {
+            for (size_t i = 0; i < positions[e].size(); i++) {
+                Position P = positions[e][i];
+                for (int col = 0; col < WIDTH; col++) {
+                    if (P.canPlay(col) && !P.isWinningMove(col)) {
+                        Position child(P);
+                        child.play(col);
+                        insert(child);
+                    }
+                }
+            }
+        }
+    }
+
+    // Retrograde pass: each layer only depends on the one solved before it
+    std::vector<typename Tablebase::Entry> solve() {
+        std::vector<typename Tablebase::Entry> entries;
+        for (int e = 1; e <= maxEmpty; e++) {
+            for (const Position& P : positions[e]) {
+                int score = scoreOf(P, e);
+                scores[e][P.key()] = int8_t(score);
+
+                // Positions the solver never searches are left out of the file
+                if (!P.canWinNext() && P.possibleNonLosingMoves() != 0) {
+                    entries.emplace_back(P.key(), int8_t(score));
+                }
+            }
+            scores[e - 1].clear();
+        }
+        return entries;
+    }
+
+    size_t positionCount() const {
+        size_t total = 0;
+        for (const auto& layer : positions) {
+            total += layer.size();
+        }
+        return total;
+    }
+
+private:
+    static int emptyCells(const Position& P) {
+        return WIDTH * HEIGHT - P.nbMoves();
+    }
+
+    void insert(const Position& P) {
+        int e = emptyCells(P);
+        if (scores[e].emplace(P.key(), 0).second) {
+            positions[e].push_back(P);
+        }
+    }
+
+    int scoreOf(const Position& P, int e) const {
+        if (P.canWinNext()) {
+            return (WIDTH * HEIGHT + 1 - P.nbMoves()) / 2;
+        }
+        int best = -WIDTH * HEIGHT;
+        for (int col = 0; col < WIDTH; col++) {
+            if (!P.canPlay(col)) {
+                continue;
+            }
+            Position child(P);
+            child.play(col);
+            int childScore = e == 1 ? 0 : scores[e - 1].at(child.key());
+            best = std::max(best, -childScore);
+        }
+        return best;
+    }
+};
+
+template <int WIDTH, int HEIGHT>
+int generate(const GeneratorOptions& options) {
+    using Tablebase = BasicConnectFourTablebase<WIDTH, HEIGHT>;
+
+    auto start = std::chrono::steady_clock::now();
+    TablebaseGenerator<WIDTH, HEIGHT> generator(options.maxEmpty);
+
+    if (options.seedFiles.empty()) {
+        generator.addRandomSeeds(options.randomGames, 12345);
+    }
+    for (const auto& path : options.seedFiles) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "Cannot open " << path << std::endl;
+            return 1;
+        }
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream fields(line);
+            std::string moves;
+            if (fields >> moves) {
+                generator.addSeed(moves);
+            }
+        }
+    }
+
+    generator.expand();
+    std::cout << "Positions: " << generator.positionCount() << std::endl;
+
+    auto entries = generator.solve();
+    std::string output = options.output.empty() ? Tablebase::defaultPath() : options.output;
+    if (!Tablebase::write(output, options.maxEmpty, entries)) {
+        std::cerr << "Cannot write " << output << std::endl;
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Wrote " << entries.size() << " entries to " << output
+              << " in " << seconds << " s" << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    GeneratorOptions options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--size" && i + 1 < argc) {
+            options.size = argv[++i];
+        } else if (arg == "--empty" && i + 1 < argc) {
+            options.maxEmpty = std::atoi(argv[++i]);
+        } else if (arg == "--random" && i + 1 < argc) {
+            options.randomGames = std::atoi(argv[++i]);
+        } else if (arg == "--output" && i + 1 < argc) {
+            options.output = argv[++i];
+        } else {
+            options.seedFiles.push_back(arg);
+        }
+    }
+
+    // Sizes match the variants offered by ConnectFourLauncher (columns x rows)
+    if (options.size == "7x6") return generate<7, 6>(options);
+    if (options.size == "8x7") return generate<8, 7>(options);
+    if (options.size == "9x7") return generate<9, 7>(options);
+    if (options.size == "9x9") return generate<9, 9>(options);
+    if (options.size == "10x10") return generate<10, 10>(options);
+
+    std::cerr << "Unknown board size " << options.size << std::endl;
+    return 1;
+}
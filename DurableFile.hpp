@@ -0,0 +1,192 @@
+#pragma once
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Writes that have reached the disk when they return, for files that must survive a crash or
+// power loss. replace() never leaves a partly written file behind: the new contents go to a
+// temporary file that is synced and then renamed over the old one.
+class DurableFile {
+public:
+    // Appends `bytes` to `path`, creating it if needed, and syncs
+    static bool append(const std::string& path, const std::string& bytes) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ, nullptr,
+                                  OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        bool ok = writeAll(file, bytes.data(), bytes.size()) && FlushFileBuffers(file);
+        CloseHandle(file);
+        return ok;
+#else
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        bool ok = writeAll(fd, bytes.data(), bytes.size()) && fsync(fd) == 0;
+        ::close(fd);
+        return ok;
+#endif
+    }
+
+    // Atomically replaces `path` with `bytes`: readers and crashes see the old or the new file.
+    // On Windows the rename fails while another handle has `path` open, so files that stay
+    // open, such as mapped boards, get a new name for each version instead.
+    static bool replace(const std::string& path, const std::string& bytes) {
+        Writer writer;
+        return writer.open(path) && writer.write(bytes.data(), bytes.size()) && writer.commit();
+    }
+
+    // Replaces a file with contents written piece by piece, for files too large to build in
+    // memory first. Nothing is visible at `path` until commit(); a Writer destroyed before
+    // that removes its temporary file.
+    class Writer {
+    private:
+        std::string path;
+        std::string temporary;
+#ifdef _WIN32
+        HANDLE file;
+#else
+        int fd;
+#endif
+        bool failed;
+
+    public:
+#ifdef _WIN32
+        Writer() : file(INVALID_HANDLE_VALUE), failed(false) {}
+#else
+        Writer() : fd(-1), failed(false) {}
+#endif
+
+        ~Writer() {
+            if (close()) {
+                std::remove(temporary.c_str());
+            }
+        }
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        bool open(const std::string& target) {
+            if (close()) {
+                std::remove(temporary.c_str());
+            }
+            path = target;
+            temporary = target + ".tmp";
+            failed = false;
+#ifdef _WIN32
+            file = CreateFileA(temporary.c_str(), GENERIC_WRITE, 0, nullptr,
+                               CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+            return file != INVALID_HANDLE_VALUE;
+#else
+            fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            return fd >= 0;
+#endif
+        }
+
+        bool write(const char* data, size_t length) {
+#ifdef _WIN32
+            failed |= file == INVALID_HANDLE_VALUE || !writeAll(file, data, length);
+#else
+            failed |= fd < 0 || !writeAll(fd, data, length);
+#endif
+            return !failed;
+        }
+
+        // Syncs the file and renames it over `path`
+        bool commit() {
+#ifdef _WIN32
+            bool ok = file != INVALID_HANDLE_VALUE && !failed && FlushFileBuffers(file);
+            close();
+            if (!ok || !MoveFileExA(temporary.c_str(), path.c_str(),
+                                    MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+                std::remove(temporary.c_str());
+                return false;
+            }
+            return true;
+#else
+            bool ok = fd >= 0 && !failed && fsync(fd) == 0;
+            close();
+            if (!ok || ::rename(temporary.c_str(), path.c_str()) != 0) {
+                std::remove(temporary.c_str());
+                return false;
+            }
+            syncDirectory(path);
+            return true;
+#endif
+        }
+
+    private:
+        // True if a file was open
+        bool close() {
+#ifdef _WIN32
+            if (file == INVALID_HANDLE_VALUE) {
+                return false;
+            }
+            CloseHandle(file);
+            file = INVALID_HANDLE_VALUE;
+#else
+            if (fd < 0) {
+                return false;
+            }
+            ::close(fd);
+            fd = -1;
+#endif
+            return true;
+        }
+    };
+
+private:
+#ifdef _WIN32
+    static bool writeAll(HANDLE file, const char* bytes, size_t length) {
+        size_t written = 0;
+        while (written < length) {
+            DWORD chunk = 0;
+            DWORD request = DWORD(length - written < 0x40000000 ? length - written : 0x40000000);
+            if (!WriteFile(file, bytes + written, request, &chunk, nullptr) || chunk == 0) {
+                return false;
+            }
+            written += chunk;
+        }
+        return true;
+    }
+#else
+    static bool writeAll(int fd, const char* bytes, size_t length) {
+        size_t written = 0;
+        while (written < length) {
+            ssize_t chunk = ::write(fd, bytes + written, length - written);
+            if (chunk < 0 && errno == EINTR) {
+                continue;
+            }
+            if (chunk <= 0) {
+                return false;
+            }
+            written += size_t(chunk);
+        }
+        return true;
+    }
+
+    // Makes the rename itself durable
+    static void syncDirectory(const std::string& path) {
+        size_t slash = path.find_last_of('/');
+        std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+        int fd = ::open(directory.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            fsync(fd);
+            ::close(fd);
+        }
+    }
+#endif
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+// Advisory lock on a lock file, held until the FileLock is destroyed. Several shared holders
+// or one exclusive holder at a time, across processes and also across threads, as each
+// FileLock opens the file on its own (flock on POSIX, LockFileEx on Windows).
+// If the lock file cannot be created, e.g. in a read-only directory, isLocked() is false and
+// the caller runs unlocked, as it did before there were locks.
+class FileLock {
+private:
+#ifdef _WIN32
+    HANDLE file;
+#else
+    int fd;
+#endif
+    bool locked;
+
+public:
+    // Blocks until the lock is granted, unless `wait` is false
+    FileLock(const std::string& path, bool exclusive, bool wait = true) : locked(false) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                           FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                           OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        OVERLAPPED overlapped = {};
+        DWORD flags = (exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0) | (wait ? 0 : LOCKFILE_FAIL_IMMEDIATELY);
+        locked = LockFileEx(file, flags, 0, MAXDWORD, MAXDWORD, &overlapped) != 0;
+#else
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return;
+        }
+        int operation = (exclusive ? LOCK_EX : LOCK_SH) | (wait ? 0 : LOCK_NB);
+        int result;
+        do {
+            result = flock(fd, operation);
+        } while (result != 0 && errno == EINTR);
+        locked = result == 0;
+#endif
+    }
+
+    ~FileLock() {
+#ifdef _WIN32
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);  // Also releases the lock
+        }
+#else
+        if (fd >= 0) {
+            ::close(fd);
+        }
+#endif
+    }
+
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+
+    bool isLocked() const { return locked; }
+
+    // False only if `wait` was false and someone else holds a conflicting lock
+    bool isGranted() const {
+#ifdef _WIN32
+        return locked || file == INVALID_HANDLE_VALUE;
+#else
+        return locked || fd < 0;
+#endif
+    }
+};
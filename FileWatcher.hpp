@@ -0,0 +1,108 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// Tells whether a file was written, created, replaced or removed since the last check, cheaply
+// enough to ask every frame. On Linux inotify watches the directory, so replacing the file by
+// renaming over it is seen too, and a check is one non-blocking read. Elsewhere, or if inotify
+// is unavailable, the file's size and modification time are compared every POLL_INTERVAL.
+class FileWatcher {
+private:
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{250};
+
+    std::string path;
+    std::string name;
+    int fd;
+    std::chrono::steady_clock::time_point lastPoll;
+    uintmax_t lastSize;
+    std::filesystem::file_time_type lastWrite;
+
+public:
+    FileWatcher() : fd(-1), lastSize(0) {}
+
+    ~FileWatcher() {
+        stop();
+    }
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    void watch(const std::string& file) {
+        stop();
+        path = file;
+        std::filesystem::path location(file);
+        name = location.filename().string();
+#ifdef __linux__
+        std::string directory = location.has_parent_path() ? location.parent_path().string() : ".";
+        fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd >= 0 && inotify_add_watch(fd, directory.c_str(),
+                                         IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_DELETE) < 0) {
+            ::close(fd);
+            fd = -1;
+        }
+#endif
+        lastPoll = std::chrono::steady_clock::now();
+        readStatus(lastSize, lastWrite);
+    }
+
+    bool changed() {
+#ifdef __linux__
+        if (fd >= 0) {
+            bool seen = false;
+            alignas(inotify_event) char buffer[4096];
+            ssize_t length;
+            while ((length = ::read(fd, buffer, sizeof(buffer))) > 0) {
+                for (char* p = buffer; p < buffer + length;) {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+                    seen |= event->len > 0 && name == event->name;
+                    p += sizeof(inotify_event) + event->len;
+                }
+            }
+            return seen;
+        }
+#endif
+        auto now = std::chrono::steady_clock::now();
+        if (path.empty() || now - lastPoll < POLL_INTERVAL) {
+            return false;
+        }
+        lastPoll = now;
+        uintmax_t size;
+        std::filesystem::file_time_type written;
+        readStatus(size, written);
+        bool result = size != lastSize || written != lastWrite;
+        lastSize = size;
+        lastWrite = written;
+        return result;
+    }
+
+private:
+    void stop() {
+#ifdef __linux__
+        if (fd >= 0) {
+            ::close(fd);
+        }
+#endif
+        fd = -1;
+    }
+
+    void readStatus(uintmax_t& size, std::filesystem::file_time_type& written) const {
+        std::error_code error;
+        size = std::filesystem::file_size(path, error);
+        if (error) {
+            size = 0;
+        }
+        written = std::filesystem::last_write_time(path, error);
+        if (error) {
+            written = std::filesystem::file_time_type();
+        }
+    }
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+// Lets a screen sleep while it has nothing to animate. A screen reads its events through
+// pollEvent() and, after drawing a frame, calls waitEvent() if nothing on it moves; the next
+// frame is then drawn only once an event arrives, instead of redrawing the same picture at
+// the frame rate limit. While something moves, frames stay capped by the window's limit.
+class FramePacer {
+private:
+    static const int WAIT_SLICE_MS = 10;  // How often a timed wait checks for events
+
+    sf::RenderWindow& window;
+    sf::Event pending;
+    bool hasPending;
+
+public:
+    explicit FramePacer(sf::RenderWindow& target) : window(target), hasPending(false) {}
+
+    // Like sf::RenderWindow::pollEvent, starting with the event a wait returned on
+    bool pollEvent(sf::Event& event) {
+        if (hasPending) {
+            event = pending;
+            hasPending = false;
+            return true;
+        }
+        return window.pollEvent(event);
+    }
+
+    // Blocks until the next event
+    void waitEvent() {
+        if (!hasPending) {
+            hasPending = window.waitEvent(pending);
+        }
+    }
+
+    // Blocks until the next event or until `timeout` passes, for screens that also show
+    // something changing outside the window, like a leaderboard shared with other consoles
+    void waitEvent(sf::Time timeout) {
+        sf::Clock clock;
+        while (!hasPending && window.isOpen()) {
+            hasPending = window.pollEvent(pending);
+            if (hasPending || clock.getElapsedTime() >= timeout) {
+                break;
+            }
+            sf::sleep(sf::milliseconds(WAIT_SLICE_MS));
+        }
+    }
+};
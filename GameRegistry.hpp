@@ -0,0 +1,62 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Numbers the game titles scores are kept for, in order of first use in this process, so a
+// score stores its game in one byte and each title is kept once. Ids are not stored in any
+// file; the files keep the titles.
+// Titles are only ever added, and a title's slot is written before its id is handed out, so
+// looking up an id takes no lock. Past CAPACITY titles, new ones all get UNKNOWN, which reads
+// as an empty title.
+class GameRegistry {
+public:
+    static const size_t CAPACITY = 255;
+    static const uint8_t UNKNOWN = 255;
+
+private:
+    std::mutex mutex;
+    std::array<std::string, CAPACITY> titles;
+    std::unordered_map<std::string_view, uint8_t> ids;  // Views of titles, which never move
+    std::atomic<size_t> count;
+
+    GameRegistry() : count(0) {
+        idOf("Snake");  // Id 0, the game of entries that name none
+    }
+
+public:
+    GameRegistry(const GameRegistry&) = delete;
+    GameRegistry& operator=(const GameRegistry&) = delete;
+
+    // The registry shared by every score in the process
+    static GameRegistry& standard() {
+        static GameRegistry registry;
+        return registry;
+    }
+
+    // The title's id, numbering it if it is new
+    uint8_t idOf(std::string_view title) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = ids.find(title);
+        if (found != ids.end()) {
+            return found->second;
+        }
+        size_t id = count.load(std::memory_order_relaxed);
+        if (id == CAPACITY) {
+            return UNKNOWN;
+        }
+        titles[id] = std::string(title);
+        ids.emplace(titles[id], uint8_t(id));
+        count.store(id + 1, std::memory_order_release);
+        return uint8_t(id);
+    }
+
+    std::string_view titleOf(uint8_t id) const {
+        return id < count.load(std::memory_order_acquire) ? std::string_view(titles[id]) : std::string_view();
+    }
+};
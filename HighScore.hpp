@@ -1,115 +1,395 @@
 #pragma once
-#include <SFML/Graphics.hpp>
 #include <string>
 #include <vector>
-#include <fstream>
 #include <algorithm>
-#include <iomanip>
-#include <sstream>
-
-class ScoreEntry {
-private:
-    std::string playerName;
-    int score;
-    std::string difficulty;
-    bool hasObstacles;
-
-public:
-    // Default constructor
-    ScoreEntry() : playerName(""), score(0), difficulty(""), hasObstacles(false) {}
-
-    // Parameter constructor
-    ScoreEntry(const std::string& name, int s, const std::string& diff, bool obs)
-        : playerName(name), score(s), difficulty(diff), hasObstacles(obs) {}
-
-    // Getters
-    std::string getPlayerName() const { return playerName; }
-    int getScore() const { return score; }
-    std::string getDifficulty() const { return difficulty; }
-    bool getHasObstacles() const { return hasObstacles; }
-
-    // Method to format score entry as string
-    std::string toString() const {
-        std::stringstream ss;
-        ss << std::left << std::setw(15) << playerName 
-           << std::setw(8) << score 
-           << std::setw(10) << difficulty
-           << (hasObstacles ? " (with obstacles)" : "");
-        return ss.str();
-    }
-
-    // Method to save to file
-    friend std::ofstream& operator<<(std::ofstream& out, const ScoreEntry& entry) {
-        out << entry.playerName << " " 
-            << entry.score << " "
-            << entry.difficulty << " "
-            << entry.hasObstacles;
-        return out;
-    }
-
-    // Method to load from file
-    friend std::ifstream& operator>>(std::ifstream& in, ScoreEntry& entry) {
-        in >> entry.playerName >> entry.score >> entry.difficulty >> entry.hasObstacles;
-        return in;
-    }
-};
+#include "FileLock.hpp"
+#include "FileWatcher.hpp"
+#include "ScoreEntry.hpp"
+#include "ScoreMerge.hpp"
+#include "ScoreTextFile.hpp"
+#include "HighScoreJournal.hpp"
+#include "HighScoreWriter.hpp"
+#include "Leaderboard.hpp"
+#include "MappedLeaderboard.hpp"
 
+// Keeps every submitted score of every game; the top MAX_SCORES of a view are the ones shown
+// on a high-score screen.
+// Most scores are answered from the memory-mapped board, so opening costs the same at any
+// size; only the scores submitted since it was written are replayed into `recent`. Every
+// board score was submitted before every recent one, which is all merging the two needs.
+//
+// Several console instances may share the files. Each one's `recent` holds the journal as far
+// as it has read it, followed by its own scores that are not written yet. refresh() reads
+// only what was appended since, once the journal is seen to change, and maps the new board
+// after anyone compacts.
 class HighScoreManager {
 private:
-    std::vector<ScoreEntry> highScores;
+    MappedLeaderboard board;
+    Leaderboard recent;
     const std::string filename;
     const int MAX_SCORES;
+    HighScoreJournal journal;
+    HighScoreWriter writer;  // After journal, so it finishes writing before the journal goes away
+    FileWatcher watcher;
+    size_t journalEntries;            // Leading entries of recent read from the journal
+    std::vector<ScoreEntry> pending;  // The rest: scores added here, not known to be written
+    size_t pendingStart;              // The writer's count of written entries before pending
+    bool compactQueued;
+    size_t compactAt;                 // Size of recent that queues the next compaction
+    bool refreshPending;              // The journal changed but could not be read yet
+
+    // Folding recent scores into a new board once there are this many bounds both the journal
+    // replayed on load and the memory they take
+    static constexpr size_t COMPACT_EVERY = 1024;
+
+    static std::string journalBase(const std::string& file) {
+        const std::string extension = ".txt";
+        if (file.size() > extension.size() &&
+            file.compare(file.size() - extension.size(), extension.size(), extension) == 0) {
+            return file.substr(0, file.size() - extension.size());
+        }
+        return file;
+    }
+
+    bool needsCompaction() const {
+        return !compactQueued && recent.size() >= compactAt;
+    }
+
+    // After a failed compaction, e.g. the board could not be written, the next one waits until
+    // recent has doubled instead of rebuilding the board on every score
+    void compactionFinished(bool succeeded) {
+        compactQueued = false;
+        compactAt = succeeded ? COMPACT_EVERY : std::max(recent.size(), COMPACT_EVERY) * 2;
+    }
+
+    void resetRecent(const std::vector<ScoreEntry>& journaled, const std::vector<ScoreEntry>& unwritten) {
+        recent.clear();
+        recent.reserve(journaled.size() + unwritten.size());
+        journalEntries = 0;
+        for (const auto& entry : journaled) {
+            journalEntries += recent.add(entry);
+        }
+        for (const auto& entry : unwritten) {
+            recent.add(entry);
+        }
+        pending = unwritten;
+    }
+
+    // Brings `recent` up to date with the files; call with at least a shared lock held, so
+    // neither the files nor the writer's count change meanwhile. True if any score changed.
+    bool readChanges() {
+        size_t written = writer.getWritten();
+        size_t newlyWritten = std::min(written - pendingStart, pending.size());
+        std::vector<ScoreEntry> unwritten(pending.begin() + newlyWritten, pending.end());
+        pendingStart = written;
+
+        std::vector<ScoreEntry> appended;
+        HighScoreJournal::Change change = journal.readNew(appended);
+        if (change == HighScoreJournal::Change::Restarted) {
+            board.open(journal.getBoardPath());
+            resetRecent(journal.readAll(board.getGeneration()), unwritten);
+            return true;
+        }
+        if (pending.empty()) {
+            // Usual for an instance nobody is playing on: only scores from elsewhere
+            for (const auto& entry : appended) {
+                journalEntries += recent.add(entry);
+            }
+            return !appended.empty();
+        }
+        if (appended.size() == newlyWritten &&
+            std::equal(appended.begin(), appended.end(), pending.begin())) {
+            // Only our own scores, already in place
+            journalEntries += appended.size();
+            pending.swap(unwritten);
+            return false;
+        }
+
+        // Scores from elsewhere landed between ours; keep the journal's order
+        std::vector<ScoreEntry> journaled = recent.entries();
+        journaled.resize(journalEntries);
+        journaled.insert(journaled.end(), appended.begin(), appended.end());
+        resetRecent(journaled, unwritten);
+        return true;
+    }
+
+    // Up to `count` entries of the view from 0-based `position`, merged from both sources
+    std::vector<ScoreEntry> mergedRange(const ScoreFilter& filter, size_t position, size_t count) const {
+        size_t boardSize = board.size(filter);
+        size_t recentSize = recent.size(filter);
+        position = std::min(position, boardSize + recentSize);
+
+        // How many of the first `position` entries come from the board: board entry i comes
+        // first while it scores at least as much as recent entry position - i - 1
+        size_t low = position > recentSize ? position - recentSize : 0;
+        size_t high = std::min(position, boardSize);
+        while (low < high) {
+            size_t fromBoard = low + (high - low) / 2;
+            if (board.scoreAt(filter, fromBoard) >= recent.scoreAt(filter, position - fromBoard - 1)) {
+                low = fromBoard + 1;
+            } else {
+                high = fromBoard;
+            }
+        }
+
+        std::vector<ScoreEntry> older = board.range(filter, low, count);
+        std::vector<ScoreEntry> newer = recent.range(filter, position - low, count);
+        std::vector<ScoreEntry> result;
+        size_t i = 0;
+        size_t j = 0;
+        while (result.size() < count && (i < older.size() || j < newer.size())) {
+            bool takeOlder = j == newer.size() ||
+                (i < older.size() && std::max(older[i].getScore(), 0) >= std::max(newer[j].getScore(), 0));
+            result.push_back(takeOlder ? older[i++] : newer[j++]);
+        }
+        return result;
+    }
+
+    // Game ids are one byte, so scores of a new game are turned away once MAX_GAMES games have
+    // scores; other instances racing past the limit are caught by Leaderboard and build()
+    bool acceptsGame(const std::string& game) const {
+        return recent.hasGame(game) || board.hasGame(game) || getGames().size() < Leaderboard::MAX_GAMES;
+    }
+
+    static void appendMissing(std::vector<std::string>& list, const std::vector<std::string>& more) {
+        for (const auto& item : more) {
+            if (std::find(list.begin(), list.end(), item) == list.end()) {
+                list.push_back(item);
+            }
+        }
+    }
 
 public:
     HighScoreManager(const std::string& file = "highscores.txt", int maxScores = 10) 
-        : filename(file), MAX_SCORES(maxScores) {
+        : filename(file), MAX_SCORES(maxScores), journal(journalBase(file)), writer(journal),
+          journalEntries(0), pendingStart(0), compactQueued(false), compactAt(COMPACT_EVERY),
+          refreshPending(false) {
         loadScores();
     }
 
+    // The leaderboard shared by every game in the console
+    static HighScoreManager& standard() {
+        static HighScoreManager manager;
+        return manager;
+    }
+
     void loadScores() {
-        std::ifstream file(filename);
-        if (file.is_open()) {
-            ScoreEntry entry;
-            while (file >> entry) {
-                highScores.push_back(entry);
+        writer.flush();
+        bool succeeded;
+        if (writer.takeFinishedCompaction(succeeded)) {
+            compactionFinished(succeeded);
+        }
+        compactQueued = false;
+        refreshPending = false;
+        watcher.watch(journal.getJournalPath());
+
+        bool outdated;
+        {
+            FileLock lock(journal.getLockPath(), true);
+            std::vector<ScoreEntry> entries = journal.load();
+            if (journal.isEmpty()) {
+                // First run with the binary formats: import the old text leaderboard once
+                std::vector<ScoreEntry> old;
+                if (ScoreTextFile::load(filename, old) && !old.empty() && journal.append(old)) {
+                    entries = journal.load();
+                }
             }
-            file.close();
+            outdated = journal.isOutdated();
+            board.open(journal.getBoardPath());
+            // Scores whose append failed are still queued for a retry, so they stay pending
+            size_t written = writer.getWritten();
+            resetRecent(entries, std::vector<ScoreEntry>(
+                pending.begin() + std::min(written - pendingStart, pending.size()), pending.end()));
+            pendingStart = written;
+        }
+
+        if (outdated || needsCompaction()) {
+            saveScores();
         }
     }
 
+    // Queues writing every score into a new board, which also starts an empty journal.
+    // The board merges whatever is on disk then, including other instances' scores.
     void saveScores() {
-        std::ofstream file(filename);
-        if (file.is_open()) {
-            for (const auto& score : highScores) {
-                file << score << "\n";
+        if (!compactQueued) {
+            compactQueued = true;
+            writer.compact();
+        }
+    }
+
+    // Picks up scores other instances saved and boards anyone wrote. Costs one non-blocking
+    // check while nothing changed, so it can run every frame; never waits for a writer.
+    // True if any score changed.
+    bool refresh() {
+        bool succeeded;
+        if (writer.takeFinishedCompaction(succeeded)) {
+            compactionFinished(succeeded);
+        }
+        refreshPending |= watcher.changed();
+        if (!refreshPending) {
+            return false;
+        }
+        FileLock lock(journal.getLockPath(), false, false);
+        if (!lock.isGranted()) {
+            return false;  // Someone is writing; try again next time
+        }
+        refreshPending = false;
+        return readChanges();
+    }
+
+    // Waits for queued writes, e.g. before another process reads the files, and reads in
+    // what other instances wrote
+    void flush() {
+        writer.flush();
+        bool succeeded;
+        if (writer.takeFinishedCompaction(succeeded)) {
+            compactionFinished(succeeded);
+        }
+        FileLock lock(journal.getLockPath(), false);
+        refreshPending = false;
+        readChanges();
+    }
+
+    // Writes every score, of every game, to a text file in submission order
+    bool exportScores(const std::string& path) const {
+        std::vector<ScoreEntry> entries = board.entries();
+        std::vector<ScoreEntry> newer = recent.entries();
+        entries.insert(entries.end(), newer.begin(), newer.end());
+        return ScoreTextFile::save(path, entries);
+    }
+
+    // Writes every score in ScoreMerge order, ready to be merged with other leaderboards
+    bool exportSortedScores(const std::string& path) const {
+        std::vector<ScoreEntry> entries = board.entries();
+        std::vector<ScoreEntry> newer = recent.entries();
+        entries.insert(entries.end(), newer.begin(), newer.end());
+        std::stable_sort(entries.begin(), entries.end(), ScoreMerge::before);
+        return ScoreTextFile::save(path, entries);
+    }
+
+    // Adds every score in a text file, as if submitted now in file order; returns how many.
+    // `skipped`, if given, receives the number of lines that did not parse or were turned away.
+    // A file big enough to call for a compaction anyway goes straight to the journal and into
+    // a new board built in one pass, instead of being indexed row by row in recent first.
+    size_t importScores(const std::string& path, size_t* skipped = nullptr) {
+        refresh();
+        ScoreTextFile::Reader reader;
+        if (!reader.open(path)) {
+            return 0;
+        }
+        // Games by registry id; scores of games past either limit are skipped
+        std::vector<bool> knownGames(size_t(GameRegistry::UNKNOWN) + 1, false);
+        size_t knownCount = 0;
+        for (const auto& title : getGames()) {
+            uint8_t id = GameRegistry::standard().idOf(title);
+            knownCount += !knownGames[id];
+            knownGames[id] = true;
+        }
+        std::vector<ScoreEntry> added;
+        ScoreEntry entry;
+        size_t rejected = 0;
+        while (reader.next(entry)) {
+            uint8_t game = entry.getGameId();
+            if (game == GameRegistry::UNKNOWN || (!knownGames[game] && knownCount == Leaderboard::MAX_GAMES)) {
+                rejected++;
+                continue;
             }
-            file.close();
+            knownCount += !knownGames[game];
+            knownGames[game] = true;
+            added.push_back(entry);
+        }
+        if (skipped) {
+            *skipped = reader.getSkipped() + rejected;
         }
+
+        if (recent.size() + added.size() >= compactAt) {
+            // Enough to rebuild the board anyway: build it with them at once, unjournaled
+            flush();
+            FileLock lock(journal.getLockPath(), true);
+            if (journal.compact(added)) {
+                compactionFinished(true);
+                readChanges();
+                return added.size();
+            }
+        }
+
+        for (const auto& score : added) {
+            recent.add(score);
+        }
+        pending.insert(pending.end(), added.begin(), added.end());
+        writer.append(added);
+        if (needsCompaction()) {
+            saveScores();
+        }
+        return added.size();
     }
 
-    bool isHighScore(int score) const {
-        if (highScores.size() < MAX_SCORES) return true;
-        return score > highScores.back().getScore();
+    // Whether the score would make the view's top MAX_SCORES, behind any equal scores
+    bool isHighScore(const ScoreFilter& filter, int score) const {
+        return board.countAtLeast(filter, score) + recent.countAtLeast(filter, score) < size_t(MAX_SCORES);
     }
 
-    void addScore(const std::string& name, int score, const std::string& diff, bool obs) {
-        highScores.emplace_back(name, score, diff, obs);
-        
-        // Sort scores in descending order
-        std::sort(highScores.begin(), highScores.end(),
-            [](const ScoreEntry& a, const ScoreEntry& b) {
-                return a.getScore() > b.getScore();
-            });
+    // False if the score was turned away: a new game with MAX_GAMES games already on the board
+    bool addScore(const std::string& game, const std::string& name, int score,
+                  const std::string& diff, bool obs) {
+        refresh();
+        if (!acceptsGame(game)) {
+            return false;
+        }
+        ScoreEntry entry(game, name, score, diff, obs);
+        recent.add(entry);
+        pending.push_back(entry);
+        writer.append(entry);
+        if (needsCompaction()) {
+            saveScores();
+        }
+        return true;
+    }
+
+    // A Snake score
+    bool addScore(const std::string& name, int score, const std::string& diff, bool obs) {
+        return addScore("Snake", name, score, diff, obs);
+    }
+
+    // 1-based rank of a score in the view; equal scores share a rank
+    size_t getRank(const ScoreFilter& filter, int score) const {
+        return board.rankOf(filter, score) + recent.rankOf(filter, score) - 1;
+    }
 
-        // Keep only top scores
-        if (highScores.size() > MAX_SCORES) {
-            highScores.erase(highScores.begin() + MAX_SCORES, highScores.end());
+    size_t getTotalScores() const {
+        return board.size() + recent.size();
+    }
+
+    size_t getScoreCount(const ScoreFilter& filter) const {
+        return board.size(filter) + recent.size(filter);
+    }
+
+    std::vector<ScoreEntry> getTopScores(const ScoreFilter& filter, size_t count) const {
+        return mergedRange(filter, 0, count);
+    }
+
+    // Up to `radius` entries on either side of the 1-based ranking position `rank`
+    std::vector<ScoreEntry> getScoresAround(const ScoreFilter& filter, size_t rank, size_t radius) const {
+        if (rank == 0) {
+            return std::vector<ScoreEntry>();
         }
+        size_t first = rank - 1 > radius ? rank - 1 - radius : 0;
+        return mergedRange(filter, first, rank - 1 - first + radius + 1);
+    }
 
-        saveScores();
+    std::vector<ScoreEntry> getHighScores(const ScoreFilter& filter = ScoreFilter()) const {
+        return mergedRange(filter, 0, MAX_SCORES);
     }
 
-    const std::vector<ScoreEntry>& getHighScores() const {
-        return highScores;
+    std::vector<std::string> getGames() const {
+        std::vector<std::string> games = board.getGames();
+        appendMissing(games, recent.getGames());
+        return games;
     }
-}; 
\ No newline at end of file
+
+    std::vector<std::string> getDifficulties(const std::string& game) const {
+        std::vector<std::string> difficulties = board.getDifficulties(game);
+        appendMissing(difficulties, recent.getDifficulties(game));
+        return difficulties;
+    }
+};
@@ -0,0 +1,417 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "DurableFile.hpp"
+#include "MappedLeaderboard.hpp"
+#include "ScoreEntry.hpp"
+
+// Crash-safe leaderboard storage: a memory-mapped board (see MappedLeaderboard) plus an
+// append-only journal of the scores submitted since it was written.
+// Every submission is one appended, checksummed journal record, so saving a score costs the
+// same at any leaderboard size. Loading only replays the journal; a record torn by a crash
+// fails its checksum and is cut off, and everything before it is intact.
+// Every write is synced before it returns. Compaction writes the next board, then starts the
+// next journal generation. A journal whose generation the board already covers is ignored,
+// so a crash between those two steps cannot replay scores twice.
+//
+// Each board is a new file named after its generation, <base>.board.<generation>, and the
+// newest one on disk is the board. Other instances keep the board mapped, and Windows cannot
+// rename a file over one that is open, so boards are never replaced in place; superseded
+// ones are deleted once compaction or load() finds them, and a failed delete is retried then.
+//
+// Several processes may share the files. Callers hold a FileLock on getLockPath(): exclusive
+// for load(), append() and compact(), shared at least for readAll() and readNew(). Writes
+// never rely on what this object read earlier: append() adds to whichever journal is current
+// on disk, and compact() folds in the board and journal found on disk, so nobody's scores are
+// overwritten. The reading side remembers how far it read, so readNew() only reads what other
+// writers appended since.
+//
+// The journal starts with a Header. Each entry is framed as uint32 length, uint32 checksum,
+// then ScoreEntry::encode bytes. Earlier versions kept a whole-file snapshot in the same
+// framing after a Header and a uint32 count; it is still read if there is no board yet.
+class HighScoreJournal {
+private:
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint64_t generation;  // Journal: its own; snapshot: the last journal it includes
+    };
+
+    // What a read found in the journal file
+    struct JournalState {
+        bool exists;
+        bool current;         // Holds scores the board does not
+        uint32_t version;
+        uint64_t generation;
+        size_t validLength;   // Header and complete records
+        size_t size;
+    };
+
+    // Version 2 added the game to every entry; version 1 files are still read
+    static const uint32_t VERSION = 2;
+
+    const std::string basePath;
+    const std::string legacyBoardPath;  // Single board file of earlier versions
+    const std::string snapshotPath;     // Older format, replaced by the board
+    const std::string journalPath;
+    const std::string lockPath;
+
+    // The reading side: the journal last read and how far. Only load(), readAll() and
+    // readNew() touch these, so a writer thread may append and compact meanwhile.
+    uint64_t generation;  // 0 if there was no current journal
+    size_t readOffset;
+    bool empty;
+    bool outdated;
+
+public:
+    enum class Change { None, Appended, Restarted };
+
+    explicit HighScoreJournal(const std::string& basePath)
+        : basePath(basePath), legacyBoardPath(basePath + ".board"), snapshotPath(basePath + ".snapshot"),
+          journalPath(basePath + ".journal"), lockPath(basePath + ".lock"), generation(0),
+          readOffset(0), empty(true), outdated(false) {}
+
+    // The newest board on disk. Hold at least a shared lock until it is opened, or a
+    // compaction may delete it first.
+    std::string getBoardPath() const {
+        uint64_t newest = 0;
+        for (uint64_t boardGeneration : findBoards()) {
+            newest = std::max(newest, boardGeneration);
+        }
+        return newest > 0 ? boardPath(newest) : legacyBoardPath;
+    }
+
+    const std::string& getJournalPath() const { return journalPath; }
+    const std::string& getLockPath() const { return lockPath; }
+
+    // Scores submitted since the board was written, in submission order. Also repairs a torn
+    // journal tail and starts a journal if there is none. Exclusive lock.
+    std::vector<ScoreEntry> load() {
+        std::vector<ScoreEntry> entries;
+        MappedLeaderboard board;
+        bool haveBoard = board.open(getBoardPath());
+        uint64_t covered = haveBoard ? board.getGeneration() : 0;
+        // An older snapshot's entries count as recent until compaction writes a board
+        bool haveSnapshot = !haveBoard && readSnapshot(entries, covered);
+        board.close();
+
+        JournalState journal = readJournal(covered, entries);
+        outdated = haveSnapshot || (journal.current && journal.version < VERSION);
+        if (journal.current && journal.validLength < journal.size) {
+            std::error_code error;
+            std::filesystem::resize_file(journalPath, journal.validLength, error);
+        }
+        if (!journal.current) {
+            // Missing, unreadable or already compacted into the board
+            journal.generation = covered + 1;
+            journal.validLength = startJournal(journal.generation) ? sizeof(Header) : 0;
+        }
+        generation = journal.generation;
+        readOffset = journal.validLength;
+        empty = !haveBoard && !haveSnapshot && !journal.exists;
+        if (haveBoard) {
+            removeBoardsBefore(covered);
+        }
+        return entries;
+    }
+
+    // True if load() found no files, e.g. before migrating an older leaderboard
+    bool isEmpty() const { return empty; }
+
+    // True if load() read an older format; compact to rewrite both files
+    bool isOutdated() const { return outdated; }
+
+    // Every score the board of generation `covered` does not hold, after another process
+    // started a new journal. Shared lock.
+    std::vector<ScoreEntry> readAll(uint64_t covered) {
+        std::vector<ScoreEntry> entries;
+        JournalState journal = readJournal(covered, entries);
+        generation = journal.current ? journal.generation : 0;
+        readOffset = journal.validLength;
+        return entries;
+    }
+
+    // Reads only the records appended since the last load(), readAll() or readNew(). On
+    // Restarted a new journal generation began, so the board was replaced: reopen it and
+    // readAll(). Shared lock.
+    Change readNew(std::vector<ScoreEntry>& entries) {
+        std::ifstream in(journalPath, std::ios::binary);
+        Header header;
+        if (generation == 0 || !in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, "HSJ1", 4) != 0 || header.generation != generation) {
+            return Change::Restarted;
+        }
+        in.seekg(0, std::ios::end);
+        size_t size = static_cast<size_t>(in.tellg());
+        if (size < readOffset) {
+            return Change::Restarted;
+        }
+        if (size == readOffset) {
+            return Change::None;
+        }
+
+        std::string bytes(size - readOffset, '\0');
+        in.seekg(static_cast<std::streamoff>(readOffset));
+        if (!in.read(&bytes[0], static_cast<std::streamsize>(bytes.size()))) {
+            return Change::None;
+        }
+        const char* data = bytes.data();
+        const char* end = data + bytes.size();
+        size_t before = entries.size();
+        ScoreEntry entry;
+        while (readRecord(data, end, entry, header.version)) {
+            entries.push_back(entry);
+        }
+        readOffset += static_cast<size_t>(data - bytes.data());
+        return entries.size() > before ? Change::Appended : Change::None;
+    }
+
+    // Several records in one write and one sync, added to the current journal on disk.
+    // Compacts first if that journal cannot take them. Exclusive lock.
+    bool append(const std::vector<ScoreEntry>& entries) {
+        if ((!isJournalWritable() && !compact()) || !cutTornTail()) {
+            return false;
+        }
+        std::string records;
+        for (const auto& entry : entries) {
+            appendRecord(records, entry);
+        }
+        return DurableFile::append(journalPath, records);
+    }
+
+    // Writes a new board holding the board on disk plus every score journaled since, and
+    // starts an empty journal. `added` scores go straight into the board, after the journal's,
+    // for bulk imports that need not be journaled first. Exclusive lock.
+    bool compact(const std::vector<ScoreEntry>& added = {}) {
+        std::string bytes;
+        uint64_t boardGeneration = 0;
+        uint64_t next;
+        {
+            std::vector<ScoreEntry> entries;
+            MappedLeaderboard board;
+            bool haveBoard = board.open(getBoardPath());
+            uint64_t covered = haveBoard ? board.getGeneration() : 0;
+            bool haveSnapshot = !haveBoard && readSnapshot(entries, covered);
+            JournalState journal = readJournal(covered, entries);
+            if (haveBoard && journal.current && journal.version == VERSION && entries.empty() &&
+                added.empty()) {
+                return true;  // Nothing to fold in
+            }
+            entries.insert(entries.end(), added.begin(), added.end());
+            if (haveBoard || haveSnapshot || !entries.empty()) {
+                boardGeneration = journal.current ? journal.generation : covered + 1;
+                bytes = MappedLeaderboard::build(boardGeneration, board, entries);
+                next = boardGeneration + 1;
+            } else {
+                next = covered + 1;
+            }
+        }
+        if (!bytes.empty()) {
+            if (!DurableFile::replace(boardPath(boardGeneration), bytes)) {
+                return false;
+            }
+            std::error_code error;
+            std::filesystem::remove(snapshotPath, error);
+        }
+        if (!startJournal(next)) {
+            return false;
+        }
+        if (!bytes.empty()) {
+            removeBoardsBefore(boardGeneration);
+        }
+        return true;
+    }
+
+private:
+    JournalState readJournal(uint64_t covered, std::vector<ScoreEntry>& entries) const {
+        JournalState state = {false, false, VERSION, 0, 0, 0};
+        std::string bytes;
+        Header header;
+        state.exists = readFile(journalPath, bytes);
+        state.size = bytes.size();
+        if (state.exists && readHeader(bytes, "HSJ1", header) && header.generation > covered) {
+            state.current = true;
+            state.version = header.version;
+            state.generation = header.generation;
+            const char* data = bytes.data() + sizeof(Header);
+            const char* end = bytes.data() + bytes.size();
+            ScoreEntry entry;
+            while (readRecord(data, end, entry, header.version)) {
+                entries.push_back(entry);
+            }
+            state.validLength = static_cast<size_t>(data - bytes.data());
+        }
+        return state;
+    }
+
+    // Whether appends may go to the journal on disk: current, and in this version's format.
+    // Boards only reach the journal's generation if a compaction stopped before starting the
+    // next journal, so the board named after it is the only one to look for.
+    bool isJournalWritable() const {
+        std::ifstream in(journalPath, std::ios::binary);
+        Header header;
+        std::error_code error;
+        return in.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+               std::memcmp(header.magic, "HSJ1", 4) == 0 && header.version == VERSION &&
+               !std::filesystem::exists(boardPath(header.generation), error);
+    }
+
+    std::string boardPath(uint64_t boardGeneration) const {
+        return basePath + ".board." + std::to_string(boardGeneration);
+    }
+
+    // Generations of the boards in the directory; temporary files and others are skipped
+    std::vector<uint64_t> findBoards() const {
+        std::vector<uint64_t> found;
+        std::filesystem::path base(basePath);
+        std::filesystem::path directory = base.has_parent_path() ? base.parent_path() : ".";
+        std::string prefix = base.filename().string() + ".board.";
+        std::error_code error;
+        for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end;
+             it.increment(error)) {
+            std::string name = it->path().filename().string();
+            if (name.size() > prefix.size() && name.size() <= prefix.size() + 19 &&
+                name.compare(0, prefix.size(), prefix) == 0 &&
+                name.find_first_not_of("0123456789", prefix.size()) == std::string::npos) {
+                found.push_back(std::stoull(name.substr(prefix.size())));
+            }
+        }
+        return found;
+    }
+
+    // Deletes the boards older than `boardGeneration`, and the earlier versions' board once a
+    // newer one exists. Instances still mapping one keep reading it: POSIX frees the file when
+    // its last mapping goes, and on Windows the delete either waits for the last handle or
+    // fails, and is retried by a later call.
+    void removeBoardsBefore(uint64_t boardGeneration) const {
+        std::error_code error;
+        bool superseded = false;
+        for (uint64_t old : findBoards()) {
+            if (old < boardGeneration) {
+                std::filesystem::remove(boardPath(old), error);
+            } else {
+                superseded = true;
+            }
+        }
+        if (superseded) {
+            std::filesystem::remove(legacyBoardPath, error);
+        }
+    }
+
+    // A record torn by a crashed writer ends what readers take from the journal, so records
+    // appended after it would be lost; cut it off first
+    bool cutTornTail() {
+        std::vector<ScoreEntry> entries;
+        JournalState journal = readJournal(0, entries);
+        if (!journal.current || journal.validLength == journal.size) {
+            return true;
+        }
+        std::error_code error;
+        std::filesystem::resize_file(journalPath, journal.validLength, error);
+        return !error;
+    }
+
+    bool readSnapshot(std::vector<ScoreEntry>& entries, uint64_t& covered) const {
+        std::string bytes;
+        Header header;
+        uint32_t count;
+        if (!readFile(snapshotPath, bytes) || !readHeader(bytes, "HSS1", header) ||
+            bytes.size() < sizeof(Header) + sizeof(count)) {
+            return false;
+        }
+        std::memcpy(&count, bytes.data() + sizeof(Header), sizeof(count));
+
+        // The snapshot is only ever replaced whole, so a bad record means a damaged file
+        const char* data = bytes.data() + sizeof(Header) + sizeof(count);
+        const char* end = bytes.data() + bytes.size();
+        ScoreEntry entry;
+        std::vector<ScoreEntry> loaded;
+        for (uint32_t i = 0; i < count; i++) {
+            if (!readRecord(data, end, entry, header.version)) {
+                return false;
+            }
+            loaded.push_back(entry);
+        }
+        entries.swap(loaded);
+        covered = header.generation;
+        return true;
+    }
+
+    bool startJournal(uint64_t journalGeneration) {
+        std::string bytes;
+        appendHeader(bytes, "HSJ1", journalGeneration);
+        return DurableFile::replace(journalPath, bytes);
+    }
+
+    static bool readFile(const std::string& path, std::string& bytes) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open()) {
+            return false;
+        }
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    static void appendHeader(std::string& bytes, const char* magic, uint64_t generation) {
+        Header header;
+        std::memcpy(header.magic, magic, 4);
+        header.version = VERSION;
+        header.generation = generation;
+        bytes.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    static bool readHeader(const std::string& bytes, const char* magic, Header& header) {
+        if (bytes.size() < sizeof(Header)) {
+            return false;
+        }
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        return std::memcmp(header.magic, magic, 4) == 0 && header.version >= 1 && header.version <= VERSION;
+    }
+
+    static void appendRecord(std::string& bytes, const ScoreEntry& entry) {
+        std::string payload;
+        entry.encode(payload);
+        uint32_t length = static_cast<uint32_t>(payload.size());
+        uint32_t sum = checksum(payload.data(), payload.size());
+        bytes.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        bytes.append(reinterpret_cast<const char*>(&sum), sizeof(sum));
+        bytes.append(payload);
+    }
+
+    static bool readRecord(const char*& data, const char* end, ScoreEntry& entry, uint32_t version) {
+        uint32_t length;
+        uint32_t sum;
+        if (end - data < static_cast<ptrdiff_t>(sizeof(length) + sizeof(sum))) {
+            return false;
+        }
+        std::memcpy(&length, data, sizeof(length));
+        std::memcpy(&sum, data + sizeof(length), sizeof(sum));
+        const char* payload = data + sizeof(length) + sizeof(sum);
+        if (static_cast<size_t>(end - payload) < length || checksum(payload, length) != sum) {
+            return false;
+        }
+        const char* cursor = payload;
+        if (!entry.decode(cursor, payload + length, version >= 2) || cursor != payload + length) {
+            return false;
+        }
+        data = payload + length;
+        return true;
+    }
+
+    // FNV-1a
+    static uint32_t checksum(const char* data, size_t length) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < length; i++) {
+            hash ^= static_cast<uint8_t>(data[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+};
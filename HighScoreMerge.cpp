@@ -0,0 +1,51 @@
+// Leaderboard merge tool.
+// Consolidates high-score text files (see ScoreTextFile.hpp) collected from several machines
+// or backups into one, keeping each distinct score once per copy a single file holds (see
+// ScoreMerge.hpp). Streams any number of rows in constant memory.
+//
+// Build: g++ -O2 -std=c++17 HighScoreMerge.cpp -o highscore_merge
+// Usage: highscore_merge output.txt input.txt...
+//        highscore_merge --sort output.txt input.txt
+//
+// Inputs must be in merge order, as HighScoreManager::exportSortedScores writes them; --sort
+// puts any other file in that order first (in memory). output.txt is only replaced once
+// complete, so it may also be one of the inputs. Exits with 1 on any error.
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ScoreMerge.hpp"
+
+int main(int argc, char** argv) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    bool sorting = !args.empty() && args[0] == "--sort";
+    if (sorting) {
+        args.erase(args.begin());
+    }
+    if (args.size() < 2 || (sorting && args.size() != 2)) {
+        std::cerr << "Usage: highscore_merge output.txt input.txt...\n"
+                  << "       highscore_merge --sort output.txt input.txt\n";
+        return 1;
+    }
+
+    std::string output = args[0];
+    std::vector<std::string> inputs(args.begin() + 1, args.end());
+    ScoreMerge::Stats stats;
+    std::string error;
+    auto start = std::chrono::steady_clock::now();
+    bool ok = sorting ? ScoreMerge::sort(inputs[0], output, stats, error)
+                      : ScoreMerge::merge(inputs, output, stats, error);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!ok) {
+        std::cerr << error << "\n";
+        if (error.find("merge order") != std::string::npos) {
+            std::cerr << "Sort that file first: highscore_merge --sort sorted.txt file.txt\n";
+        }
+        return 1;
+    }
+
+    std::cout << stats.read << " scores read, " << stats.written << " written, "
+              << stats.duplicates << " duplicates dropped, " << stats.skipped
+              << " unreadable lines skipped in " << seconds << " s\n";
+    return 0;
+}
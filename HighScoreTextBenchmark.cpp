@@ -0,0 +1,213 @@
+// High-score text format benchmark.
+// Writes and loads a large leaderboard with ScoreTextFile, compares the load against a plain
+// read of the same bytes and against the old whitespace-split iostream parsing, checks that
+// damaged lines are skipped on their own, then times importing and exporting the file through
+// HighScoreManager.
+//
+// Build: g++ -O2 -std=c++17 -pthread HighScoreTextBenchmark.cpp -o highscore_text_bench
+// Usage: highscore_text_bench [rows] [directory]
+//
+// Rows default to 1000000. Files are created in `directory` (default: the current one) and
+// removed afterwards. Exits with 1 if any check fails.
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "HighScore.hpp"
+#include "ScoreTextFile.hpp"
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char* label, double seconds, size_t bytes, size_t rows) {
+    std::cout << std::left << std::setw(28) << label << std::right << std::fixed
+              << std::setprecision(3) << std::setw(9) << seconds << " s"
+              << std::setprecision(1) << std::setw(10) << bytes / seconds / 1e6 << " MB/s"
+              << std::setprecision(2) << std::setw(10) << rows / seconds / 1e6 << " M rows/s\n";
+}
+
+static std::vector<ScoreEntry> generate(size_t rows, bool plainNames) {
+    static const char* games[] = {"Snake", "Tic Tac Toe", "Connect Four 7x6", "Rock Paper Scissors"};
+    static const char* difficulties[] = {"Easy", "Medium", "Hard", "Negamax", "Monte Carlo"};
+    static const char letters[] = "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ\"\\";
+    std::mt19937 random(12345);
+    std::vector<ScoreEntry> entries;
+    entries.reserve(rows);
+    for (size_t i = 0; i < rows; i++) {
+        std::string name;
+        size_t length = 1 + random() % 15;
+        for (size_t c = 0; c < length; c++) {
+            name.push_back(letters[random() % (plainNames ? 26 : sizeof(letters) - 1)]);
+        }
+        entries.push_back(ScoreEntry(plainNames ? "Snake" : games[random() % 4], name, int(random() % 100000),
+                                     difficulties[random() % (plainNames ? 3 : 5)], random() % 2 == 0));
+    }
+    return entries;
+}
+
+static bool sameEntry(const ScoreEntry& a, const ScoreEntry& b) {
+    return a.getGame() == b.getGame() && a.getPlayerName() == b.getPlayerName() &&
+           a.getScore() == b.getScore() && a.getDifficulty() == b.getDifficulty() &&
+           a.getHasObstacles() == b.getHasObstacles();
+}
+
+static size_t fileSize(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    return in.is_open() ? size_t(in.tellg()) : 0;
+}
+
+int main(int argc, char** argv) {
+    size_t rows = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    std::string directory = argc > 2 ? std::string(argv[2]) + "/" : "";
+    std::string textPath = directory + "bench_scores.txt";
+    std::string legacyPath = directory + "bench_legacy.txt";
+    std::string damagedPath = directory + "bench_damaged.txt";
+    std::string managerPath = directory + "bench_manager.txt";
+    std::string exportPath = directory + "bench_export.txt";
+    bool ok = true;
+
+    std::vector<ScoreEntry> entries = generate(rows, false);
+
+    auto start = std::chrono::steady_clock::now();
+    if (!ScoreTextFile::save(textPath, entries)) {
+        std::cerr << "Cannot write " << textPath << "\n";
+        return 1;
+    }
+    size_t bytes = fileSize(textPath);
+    report("save (synced)", secondsSince(start), bytes, rows);
+
+    // What reading the bytes costs with no parsing at all
+    start = std::chrono::steady_clock::now();
+    {
+        std::vector<char> buffer(1 << 20);
+        FILE* file = std::fopen(textPath.c_str(), "rb");
+        size_t total = 0;
+        size_t chunk;
+        while (file && (chunk = std::fread(buffer.data(), 1, buffer.size(), file)) > 0) {
+            total += chunk;
+        }
+        if (file) {
+            std::fclose(file);
+        }
+        ok = ok && total == bytes;
+    }
+    report("read only", secondsSince(start), bytes, rows);
+
+    std::vector<ScoreEntry> loaded;
+    loaded.reserve(rows);
+    size_t skipped = 0;
+    start = std::chrono::steady_clock::now();
+    ScoreTextFile::load(textPath, loaded, &skipped);
+    report("load", secondsSince(start), bytes, rows);
+    if (loaded.size() != rows || skipped != 0) {
+        std::cerr << "load: " << loaded.size() << " rows, " << skipped << " skipped\n";
+        ok = false;
+    }
+    for (size_t i = 0; ok && i < rows; i++) {
+        if (!sameEntry(loaded[i], entries[i])) {
+            std::cerr << "load: row " << i << " differs: " << loaded[i].toString() << "\n";
+            ok = false;
+        }
+    }
+
+    // The original format, read the way the game used to: names without spaces only
+    std::vector<ScoreEntry> plain = generate(rows, true);
+    {
+        std::ofstream out(legacyPath);
+        for (const auto& entry : plain) {
+            out << entry.getPlayerName() << " " << entry.getScore() << " "
+                << entry.getDifficultyName() << " " << entry.getHasObstacles() << "\n";
+        }
+    }
+    size_t legacyBytes = fileSize(legacyPath);
+    start = std::chrono::steady_clock::now();
+    {
+        std::ifstream in(legacyPath);
+        std::string name;
+        std::string difficulty;
+        int score;
+        bool obstacles;
+        loaded.clear();
+        while (in >> name >> score >> difficulty >> obstacles) {
+            loaded.push_back(ScoreEntry(name, score, difficulty, obstacles));
+        }
+    }
+    report("old format, iostream", secondsSince(start), legacyBytes, loaded.size());
+    loaded.clear();
+    start = std::chrono::steady_clock::now();
+    ScoreTextFile::load(legacyPath, loaded);
+    report("old format, load", secondsSince(start), legacyBytes, loaded.size());
+    for (size_t i = 0; ok && i < rows; i++) {
+        if (loaded.size() != rows || !sameEntry(loaded[i], plain[i])) {
+            std::cerr << "old format: row " << i << " differs\n";
+            ok = false;
+        }
+    }
+    plain.clear();
+    plain.shrink_to_fit();
+
+    // Every 1000th line damaged in a different way; all others must survive
+    {
+        static const char* damage[] = {"\"unterminated 5 \"Easy\" 0\n", "\"name\" twelve \"Easy\" 0\n",
+                                       "\"name\" 5 \"Easy\" 7\n", "\"name\" 5\n", "\"na\"me\" 5 \"Easy\" 0\n",
+                                       "\"name\" 99999999999 \"Easy\" 0\n", "\"name\" 5 \"Easy\" 0 \"Snake\" extra\n"};
+        std::string text;
+        size_t damaged = 0;
+        for (size_t i = 0; i < rows; i++) {
+            if (i % 1000 == 999) {
+                text += damage[damaged++ % 7];
+            }
+            ScoreTextFile::format(text, entries[i]);
+        }
+        std::ofstream(damagedPath, std::ios::binary) << text;
+        loaded.clear();
+        ScoreTextFile::load(damagedPath, loaded, &skipped);
+        if (loaded.size() != rows || skipped != damaged) {
+            std::cerr << "damaged: " << loaded.size() << " rows, " << skipped << " of "
+                      << damaged << " bad lines skipped\n";
+            ok = false;
+        }
+        for (size_t i = 0; ok && i < rows; i++) {
+            if (!sameEntry(loaded[i], entries[i])) {
+                std::cerr << "damaged: row " << i << " differs\n";
+                ok = false;
+            }
+        }
+        std::cout << "damaged file: " << damaged << " bad lines skipped, " << loaded.size() << " rows kept\n";
+    }
+    loaded.clear();
+    loaded.shrink_to_fit();
+
+    // Through the leaderboard, including its journal and board
+    {
+        HighScoreManager manager(managerPath);
+        start = std::chrono::steady_clock::now();
+        size_t imported = manager.importScores(textPath);
+        manager.flush();
+        report("manager import (synced)", secondsSince(start), bytes, imported);
+        ok = ok && imported == rows && manager.getTotalScores() == rows;
+
+        start = std::chrono::steady_clock::now();
+        manager.exportScores(exportPath);
+        report("manager export (synced)", secondsSince(start), fileSize(exportPath), rows);
+        ok = ok && fileSize(exportPath) == bytes;
+    }
+
+    for (const std::string& base : {managerPath.substr(0, managerPath.size() - 4)}) {
+        HighScoreJournal journal(base);
+        std::remove(journal.getBoardPath().c_str());
+        std::remove(journal.getJournalPath().c_str());
+        std::remove(journal.getLockPath().c_str());
+    }
+    for (const std::string& path : {textPath, legacyPath, damagedPath, exportPath}) {
+        std::remove(path.c_str());
+    }
+
+    std::cout << (ok ? "All checks passed\n" : "Checks FAILED\n");
+    return ok ? 0 : 1;
+}
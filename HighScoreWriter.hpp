@@ -0,0 +1,165 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "FileLock.hpp"
+#include "HighScoreJournal.hpp"
+
+// Persists leaderboard changes on a background thread, so the game never waits on the disk.
+// Requests only queue work. The writer takes everything queued since its last write, so a
+// burst of scores costs one journal append and one sync, and a queued compaction runs right
+// after that append, so it includes those scores. Each write holds the journal's exclusive
+// lock; getWritten() changes only while it is held, so a reader holding the shared lock knows
+// exactly which of this process's scores the files contain. A batch that could not be appended
+// goes back to the front of the queue and is retried after a growing delay.
+class HighScoreWriter {
+private:
+    // How long the writer waits for more scores after the first of a burst
+    static constexpr std::chrono::milliseconds COALESCE_DELAY{50};
+    // How long the writer waits before retrying a failed append, doubling up to the maximum
+    static constexpr std::chrono::milliseconds RETRY_DELAY{100};
+    static constexpr std::chrono::milliseconds MAX_RETRY_DELAY{5000};
+
+    HighScoreJournal& journal;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+
+    // Guarded by mutex
+    bool stopping;
+    bool writing;
+    bool compactPending;
+    bool compactFinished;
+    bool compactSucceeded;
+    bool failing;    // The last append failed; its batch waits at the front of appends
+    size_t written;  // Appended entries written so far, in submission order
+    std::vector<ScoreEntry> appends;
+
+public:
+    // The journal must outlive the writer
+    explicit HighScoreWriter(HighScoreJournal& target)
+        : journal(target), stopping(false), writing(false), compactPending(false),
+          compactFinished(false), compactSucceeded(false), failing(false), written(0) {
+        worker = std::thread(&HighScoreWriter::run, this);
+    }
+
+    // Finishes every queued write first
+    ~HighScoreWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    HighScoreWriter(const HighScoreWriter&) = delete;
+    HighScoreWriter& operator=(const HighScoreWriter&) = delete;
+
+    void append(const ScoreEntry& entry) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            appends.push_back(entry);
+        }
+        wake.notify_one();
+    }
+
+    void append(const std::vector<ScoreEntry>& entries) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            appends.insert(appends.end(), entries.begin(), entries.end());
+        }
+        wake.notify_one();
+    }
+
+    void compact() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            compactPending = true;
+        }
+        wake.notify_one();
+    }
+
+    // True once per finished compaction, with whether the new board was written
+    bool takeFinishedCompaction(bool& succeeded) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!compactFinished) {
+            return false;
+        }
+        compactFinished = false;
+        succeeded = compactSucceeded;
+        return true;
+    }
+
+    // How many of the appended entries have been written
+    size_t getWritten() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return written;
+    }
+
+    // Blocks until everything queued so far is on disk, or an append failed and awaits a retry
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return !writing && (failing || (!compactPending && appends.empty())); });
+    }
+
+private:
+    void run() {
+        std::chrono::milliseconds retryDelay = RETRY_DELAY;
+        while (true) {
+            bool compacting;
+            std::vector<ScoreEntry> batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if (failing) {
+                    wake.wait_for(lock, retryDelay, [this] { return stopping; });
+                } else {
+                    wake.wait(lock, [this] { return stopping || compactPending || !appends.empty(); });
+                    if (!stopping && !compactPending) {
+                        wake.wait_for(lock, COALESCE_DELAY, [this] { return stopping || compactPending; });
+                    }
+                }
+                if (!compactPending && appends.empty()) {
+                    return;  // Stopping with nothing left to write
+                }
+                compacting = compactPending;
+                compactPending = false;
+                batch.swap(appends);
+                writing = true;
+            }
+
+            bool giveUp;
+            {
+                FileLock fileLock(journal.getLockPath(), true);
+                bool appended = batch.empty() || journal.append(batch);
+                // A compaction waits for the scores queued before it, so it never runs without them
+                bool compacted = appended && compacting && journal.compact();
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (appended) {
+                    written += batch.size();
+                } else {
+                    appends.insert(appends.begin(), batch.begin(), batch.end());
+                }
+                failing = !appended;
+                writing = false;
+                if (compacting && appended) {
+                    compactFinished = true;
+                    compactSucceeded = compacted;
+                } else if (compacting) {
+                    compactPending = true;
+                }
+                giveUp = failing && stopping;  // One last try on the way out; nothing can wait
+            }
+            idle.notify_all();
+            if (giveUp) {
+                return;
+            }
+            retryDelay = failing ? std::min(retryDelay * 2, MAX_RETRY_DELAY) : RETRY_DELAY;
+        }
+    }
+};
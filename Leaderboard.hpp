@@ -0,0 +1,456 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "ScoreEntry.hpp"
+
+// A view of one game's leaderboard; empty strings and Any match everything
+struct ScoreFilter {
+    enum class Obstacles { Any, With, Without };
+
+    std::string game;
+    std::string difficulty;
+    Obstacles obstacles;
+    std::string player;
+
+    explicit ScoreFilter(const std::string& gameName = "Snake", const std::string& diff = "",
+                         Obstacles obs = Obstacles::Any, const std::string& name = "")
+        : game(gameName), difficulty(diff), obstacles(obs), player(name) {}
+};
+
+// Every score ever submitted, for every game, ranked by score (highest first, earlier
+// submissions first among equal scores).
+//
+// Each game has a rank index per mode: one for all of its scores, one per difficulty, one per
+// obstacle setting and one per combination. A rank index is an order-statistic tree over the
+// distinct score values holding, per value, the entries in submission order, so a filtered view
+// answers rank queries in O(log D), where D is the number of distinct scores in it, and lists
+// K entries in O(K + log D) per distinct score among them. Each player also has a sorted list
+// per game; those are short, so player views with further filters scan them.
+//
+// Rows take 12 bytes with names and labels interned, plus 4 bytes in each of the five indexes
+// and a tree node per distinct score in each of its four rank indexes.
+// Scores below zero are ranked as zero.
+class Leaderboard {
+private:
+    struct Row {
+        int32_t score;
+        uint32_t name;
+        uint16_t difficulty;
+        uint8_t game;
+        bool obstacles;
+    };
+
+    // Each distinct string is stored once
+    template <typename Id>
+    class StringPool {
+    private:
+        std::vector<std::string> strings;
+        std::unordered_map<std::string, Id> ids;
+        std::string key;  // Reused for lookups, so interning a known string never allocates
+
+    public:
+        Id intern(std::string_view text) {
+            key.assign(text.data(), text.size());
+            auto found = ids.find(key);
+            if (found != ids.end()) {
+                return found->second;
+            }
+            Id id = Id(strings.size());
+            strings.push_back(key);
+            ids.emplace(key, id);
+            return id;
+        }
+
+        // Whether interning `text` keeps the pool within `limit` strings
+        bool fits(std::string_view text, size_t limit) {
+            key.assign(text.data(), text.size());
+            return strings.size() < limit || ids.count(key) != 0;
+        }
+
+        bool find(const std::string& text, Id& id) const {
+            auto found = ids.find(text);
+            if (found == ids.end()) {
+                return false;
+            }
+            id = found->second;
+            return true;
+        }
+
+        const std::string& get(Id id) const { return strings[id]; }
+        size_t size() const { return strings.size(); }
+
+        void clear() {
+            strings.clear();
+            ids.clear();
+        }
+    };
+
+    // Order statistics over the rows of one view: a treap with a node per distinct score value,
+    // each counting the entries in its subtree, so memory follows the entries and not the
+    // score range
+    class RankIndex {
+    private:
+        struct Node {
+            uint32_t value;
+            uint32_t total;     // Entries in this subtree
+            uint32_t left;      // Lower values; 0 is no node
+            uint32_t right;
+            uint32_t priority;
+        };
+
+        std::vector<Node> nodes;                   // nodes[0] is the empty subtree
+        std::vector<std::vector<uint32_t>> rows;   // Row ids per node, in submission order
+        uint32_t root;
+        uint32_t seed;
+
+    public:
+        RankIndex() : nodes(1, Node{0, 0, 0, 0, 0}), rows(1), root(0), seed(2463534242u) {}
+
+        size_t size() const { return nodes[root].total; }
+
+        // Values are ranking scores, so they fit in 31 bits
+        void add(size_t value, uint32_t row) {
+            root = insert(root, uint32_t(value), row);
+        }
+
+        size_t countAtLeast(size_t value) const {
+            size_t total = 0;
+            for (uint32_t node = root; node != 0;) {
+                const Node& current = nodes[node];
+                if (current.value >= value) {
+                    total += current.total - nodes[current.left].total;
+                    node = current.left;
+                } else {
+                    node = current.right;
+                }
+            }
+            return total;
+        }
+
+        size_t countAbove(size_t value) const {
+            return countAtLeast(value + 1);
+        }
+
+        // Appends up to `limit` row ids starting at 0-based ranking `position`
+        void range(size_t position, size_t limit, std::vector<uint32_t>& out) const {
+            size_t end = out.size() + limit;
+            while (out.size() < end && position < size()) {
+                size_t offset = position;
+                const std::vector<uint32_t>& bucket = rows[nodeAt(offset)];
+                for (; offset < bucket.size() && out.size() < end; offset++, position++) {
+                    out.push_back(bucket[offset]);
+                }
+            }
+        }
+
+    private:
+        // Node holding the entry at 0-based `position`; leaves the offset within it in `position`
+        uint32_t nodeAt(size_t& position) const {
+            uint32_t node = root;
+            while (true) {
+                const Node& current = nodes[node];
+                size_t above = nodes[current.right].total;
+                size_t here = current.total - above - nodes[current.left].total;
+                if (position < above) {
+                    node = current.right;
+                } else if (position < above + here) {
+                    position -= above;
+                    return node;
+                } else {
+                    position -= above + here;
+                    node = current.left;
+                }
+            }
+        }
+
+        uint32_t insert(uint32_t node, uint32_t value, uint32_t row) {
+            if (node == 0) {
+                seed ^= seed << 13;
+                seed ^= seed >> 17;
+                seed ^= seed << 5;
+                nodes.push_back(Node{value, 1, 0, 0, seed});
+                rows.push_back(std::vector<uint32_t>(1, row));
+                return uint32_t(nodes.size() - 1);
+            }
+            nodes[node].total++;
+            if (value == nodes[node].value) {
+                rows[node].push_back(row);
+            } else if (value < nodes[node].value) {
+                uint32_t child = insert(nodes[node].left, value, row);
+                nodes[node].left = child;
+                if (nodes[child].priority > nodes[node].priority) {
+                    node = rotateRight(node);
+                }
+            } else {
+                uint32_t child = insert(nodes[node].right, value, row);
+                nodes[node].right = child;
+                if (nodes[child].priority > nodes[node].priority) {
+                    node = rotateLeft(node);
+                }
+            }
+            return node;
+        }
+
+        uint32_t rotateRight(uint32_t node) {
+            uint32_t child = nodes[node].left;
+            nodes[node].left = nodes[child].right;
+            nodes[child].right = node;
+            nodes[child].total = nodes[node].total;
+            nodes[node].total = nodes[nodes[node].left].total + nodes[nodes[node].right].total +
+                                uint32_t(rows[node].size());
+            return child;
+        }
+
+        uint32_t rotateLeft(uint32_t node) {
+            uint32_t child = nodes[node].right;
+            nodes[node].right = nodes[child].left;
+            nodes[child].left = node;
+            nodes[child].total = nodes[node].total;
+            nodes[node].total = nodes[nodes[node].left].total + nodes[nodes[node].right].total +
+                                uint32_t(rows[node].size());
+            return child;
+        }
+    };
+
+    static const uint16_t ANY_DIFFICULTY = 0xFFFF;
+    static const int ANY_OBSTACLES = 2;
+
+    std::vector<Row> rows;  // In submission order
+    std::unordered_map<uint64_t, RankIndex> modes;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> players;  // Row ids, in ranking order
+    StringPool<uint32_t> names;
+    StringPool<uint16_t> difficulties;
+    StringPool<uint8_t> games;
+
+public:
+    // Game ids are one byte; scores of further games are turned away
+    static const size_t MAX_GAMES = 256;
+
+    void clear() {
+        rows.clear();
+        modes.clear();
+        players.clear();
+        names.clear();
+        difficulties.clear();
+        games.clear();
+    }
+
+    void reserve(size_t count) {
+        rows.reserve(count);
+    }
+
+    size_t size() const { return rows.size(); }
+
+    // Adds a score; false if it is of a new game and MAX_GAMES games already have scores
+    bool add(const ScoreEntry& entry) {
+        if (!games.fits(entry.getGame(), MAX_GAMES)) {
+            return false;
+        }
+        Row row;
+        row.score = entry.getScore();
+        row.name = names.intern(entry.getPlayerName());
+        row.difficulty = difficulties.intern(entry.getDifficultyName());
+        row.game = games.intern(entry.getGame());
+        row.obstacles = entry.getHasObstacles();
+
+        uint32_t id = uint32_t(rows.size());
+        rows.push_back(row);
+
+        size_t value = valueOf(row.score);
+        modes[modeKey(row.game, row.difficulty, row.obstacles)].add(value, id);
+        modes[modeKey(row.game, row.difficulty, ANY_OBSTACLES)].add(value, id);
+        modes[modeKey(row.game, ANY_DIFFICULTY, row.obstacles)].add(value, id);
+        modes[modeKey(row.game, ANY_DIFFICULTY, ANY_OBSTACLES)].add(value, id);
+
+        std::vector<uint32_t>& list = players[playerKey(row.game, row.name)];
+        list.insert(std::upper_bound(list.begin(), list.end(), id,
+            [this](uint32_t a, uint32_t b) { return valueOf(rows[a].score) > valueOf(rows[b].score); }), id);
+        return true;
+    }
+
+    bool hasGame(const std::string& game) const {
+        uint8_t id;
+        return games.find(game, id);
+    }
+
+    // Number of entries in the view
+    size_t size(const ScoreFilter& filter) const {
+        return countAtLeast(filter, 0);
+    }
+
+    // Number of entries in the view scoring at least `score`; a new entry with this score
+    // would go right after them
+    size_t countAtLeast(const ScoreFilter& filter, int score) const {
+        return count(filter, score, true);
+    }
+
+    // 1-based rank of a score in the view, with equal scores sharing a rank
+    size_t rankOf(const ScoreFilter& filter, int score) const {
+        return count(filter, score, false) + 1;
+    }
+
+    // Up to `count` entries of the view starting at 0-based `position`, in ranking order
+    std::vector<ScoreEntry> range(const ScoreFilter& filter, size_t position, size_t count) const {
+        std::vector<ScoreEntry> result;
+        Query query;
+        if (!resolve(filter, query)) {
+            return result;
+        }
+
+        std::vector<uint32_t> ids;
+        if (query.players) {
+            for (uint32_t id : *query.players) {
+                if (ids.size() == count) {
+                    break;
+                }
+                if (!matches(query, rows[id])) {
+                    continue;
+                }
+                if (position > 0) {
+                    position--;
+                    continue;
+                }
+                ids.push_back(id);
+            }
+        } else {
+            query.mode->range(position, count, ids);
+        }
+
+        result.reserve(ids.size());
+        for (uint32_t id : ids) {
+            result.push_back(entryOf(rows[id]));
+        }
+        return result;
+    }
+
+    // Ranking score (negative scores as zero) of the entry at 0-based `position` in the view
+    int scoreAt(const ScoreFilter& filter, size_t position) const {
+        std::vector<ScoreEntry> entry = range(filter, position, 1);
+        return entry.empty() ? 0 : int(valueOf(entry.front().getScore()));
+    }
+
+    std::vector<ScoreEntry> top(const ScoreFilter& filter, size_t count) const {
+        return range(filter, 0, count);
+    }
+
+    // The entry at `position` with up to `radius` entries on either side
+    std::vector<ScoreEntry> around(const ScoreFilter& filter, size_t position, size_t radius) const {
+        size_t first = position > radius ? position - radius : 0;
+        return range(filter, first, position - first + radius + 1);
+    }
+
+    // Every game with at least one score, in order of first score
+    std::vector<std::string> getGames() const {
+        std::vector<std::string> result;
+        for (size_t id = 0; id < games.size(); id++) {
+            result.push_back(games.get(uint8_t(id)));
+        }
+        return result;
+    }
+
+    // Every difficulty the game has scores for, in order of first score
+    std::vector<std::string> getDifficulties(const std::string& game) const {
+        std::vector<std::string> result;
+        uint8_t gameId;
+        if (games.find(game, gameId)) {
+            for (size_t id = 0; id < difficulties.size(); id++) {
+                if (modes.count(modeKey(gameId, uint16_t(id), ANY_OBSTACLES))) {
+                    result.push_back(difficulties.get(uint16_t(id)));
+                }
+            }
+        }
+        return result;
+    }
+
+    // All entries in submission order, e.g. for a snapshot
+    std::vector<ScoreEntry> entries() const {
+        std::vector<ScoreEntry> result;
+        result.reserve(rows.size());
+        for (const Row& row : rows) {
+            result.push_back(entryOf(row));
+        }
+        return result;
+    }
+
+private:
+    // A filter resolved to an index: a mode index, or a player's list plus the remaining filters
+    struct Query {
+        const RankIndex* mode = nullptr;
+        const std::vector<uint32_t>* players = nullptr;
+        uint16_t difficulty = ANY_DIFFICULTY;
+        int obstacles = ANY_OBSTACLES;
+    };
+
+    bool resolve(const ScoreFilter& filter, Query& query) const {
+        uint8_t game;
+        if (!games.find(filter.game, game)) {
+            return false;
+        }
+        if (!filter.difficulty.empty() && !difficulties.find(filter.difficulty, query.difficulty)) {
+            return false;
+        }
+        query.obstacles = filter.obstacles == ScoreFilter::Obstacles::Any ? ANY_OBSTACLES
+                        : filter.obstacles == ScoreFilter::Obstacles::With ? 1 : 0;
+
+        if (!filter.player.empty()) {
+            uint32_t name;
+            if (!names.find(filter.player, name)) {
+                return false;
+            }
+            auto found = players.find(playerKey(game, name));
+            query.players = found != players.end() ? &found->second : nullptr;
+            return query.players != nullptr;
+        }
+
+        auto found = modes.find(modeKey(game, query.difficulty, query.obstacles));
+        query.mode = found != modes.end() ? &found->second : nullptr;
+        return query.mode != nullptr;
+    }
+
+    // Entries of the view scoring more than `score`, or as much with `inclusive`
+    size_t count(const ScoreFilter& filter, int score, bool inclusive) const {
+        Query query;
+        if (!resolve(filter, query)) {
+            return 0;
+        }
+        size_t value = valueOf(score);
+        if (query.players) {
+            size_t total = 0;
+            for (uint32_t id : *query.players) {
+                size_t rowValue = valueOf(rows[id].score);
+                if (rowValue < value || (rowValue == value && !inclusive)) {
+                    break;
+                }
+                total += matches(query, rows[id]);
+            }
+            return total;
+        }
+        return inclusive ? query.mode->countAtLeast(value) : query.mode->countAbove(value);
+    }
+
+    static bool matches(const Query& query, const Row& row) {
+        return (query.difficulty == ANY_DIFFICULTY || row.difficulty == query.difficulty) &&
+               (query.obstacles == ANY_OBSTACLES || int(row.obstacles) == query.obstacles);
+    }
+
+    static uint64_t modeKey(uint8_t game, uint16_t difficulty, int obstacles) {
+        return (uint64_t(game) << 24) | (uint64_t(difficulty) << 8) | uint64_t(obstacles);
+    }
+
+    static uint64_t playerKey(uint8_t game, uint32_t name) {
+        return (uint64_t(game) << 32) | name;
+    }
+
+    static size_t valueOf(int score) {
+        return score > 0 ? size_t(score) : 0;
+    }
+
+    ScoreEntry entryOf(const Row& row) const {
+        return ScoreEntry(games.get(row.game), names.get(row.name), row.score,
+                          difficulties.get(row.difficulty), row.obstacles);
+    }
+};
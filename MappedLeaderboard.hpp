@@ -0,0 +1,717 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Leaderboard.hpp"
+#include "MappedFile.hpp"
+#include "ScoreEntry.hpp"
+
+// Read-only leaderboard answered straight from a memory-mapped file.
+// Opening maps the file and checks its header, so it costs the same at any size; queries
+// binary-search the sorted indexes in place and only the pages they touch are ever read.
+// Files are written whole by build(), so a board never changes once mapped.
+//
+// Layout (native endianness, sections 8-byte aligned):
+//   Header
+//   Row[rowCount]                  fixed-size records in submission order
+//   uint32 stringOffsets[count+1]  names (sorted), then difficulties, then games
+//   char strings[]
+//   View[viewCount]                sorted by game, difficulty, obstacles
+//   Player[playerCount]            sorted by game, name
+//   uint32 ids[]                   row ids of each view and player list, in ranking order
+// Ranking is by score, highest first, earlier submissions first among equal scores; scores
+// below zero rank as zero, as in Leaderboard.
+class MappedLeaderboard {
+private:
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint64_t generation;  // Last journal generation folded into this board
+        uint64_t rowCount;
+        uint32_t nameCount;
+        uint32_t difficultyCount;
+        uint32_t gameCount;
+        uint32_t viewCount;
+        uint64_t playerCount;
+        uint64_t rowsOffset;
+        uint64_t stringOffsetsOffset;
+        uint64_t stringsOffset;
+        uint64_t viewsOffset;
+        uint64_t playersOffset;
+        uint64_t idsOffset;
+        uint64_t idCount;
+        uint64_t fileSize;
+    };
+
+    struct Row {
+        int32_t score;
+        uint32_t name;
+        uint16_t difficulty;
+        uint8_t game;
+        uint8_t obstacles;
+    };
+
+    struct View {
+        uint8_t game;
+        uint8_t obstacles;    // 0, 1, or ANY_OBSTACLES
+        uint16_t difficulty;  // Or ANY_DIFFICULTY
+        uint32_t reserved;
+        uint64_t first;       // Into ids
+        uint64_t count;
+    };
+
+    struct Player {
+        uint32_t name;
+        uint8_t game;
+        uint8_t reserved[3];
+        uint64_t first;
+        uint64_t count;
+    };
+
+    static const uint32_t VERSION = 1;
+    static const uint16_t ANY_DIFFICULTY = 0xFFFF;
+    static const uint8_t ANY_OBSTACLES = 2;
+    static constexpr uint32_t NO_ID = 0xFFFFFFFF;
+
+    MappedFile file;
+    const Header* header;
+    const Row* rows;
+    const uint32_t* stringOffsets;
+    const char* strings;
+    const View* views;
+    const Player* players;
+    const uint32_t* ids;
+
+public:
+    MappedLeaderboard() {
+        close();
+    }
+
+    MappedLeaderboard(const MappedLeaderboard&) = delete;
+    MappedLeaderboard& operator=(const MappedLeaderboard&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+        if (!file.open(path) || file.size() < sizeof(Header)) {
+            close();
+            return false;
+        }
+        const Header* candidate = reinterpret_cast<const Header*>(file.data());
+        if (std::memcmp(candidate->magic, "HSB1", 4) != 0 || candidate->version != VERSION ||
+            candidate->fileSize != file.size() || !sectionsFit(*candidate)) {
+            close();
+            return false;
+        }
+
+        header = candidate;
+        const char* base = file.data();
+        rows = reinterpret_cast<const Row*>(base + header->rowsOffset);
+        stringOffsets = reinterpret_cast<const uint32_t*>(base + header->stringOffsetsOffset);
+        strings = base + header->stringsOffset;
+        views = reinterpret_cast<const View*>(base + header->viewsOffset);
+        players = reinterpret_cast<const Player*>(base + header->playersOffset);
+        ids = reinterpret_cast<const uint32_t*>(base + header->idsOffset);
+        return true;
+    }
+
+    void close() {
+        file.close();
+        header = nullptr;
+        rows = nullptr;
+        stringOffsets = nullptr;
+        strings = nullptr;
+        views = nullptr;
+        players = nullptr;
+        ids = nullptr;
+    }
+
+    bool isOpen() const { return header != nullptr; }
+    uint64_t getGeneration() const { return header ? header->generation : 0; }
+    size_t size() const { return header ? size_t(header->rowCount) : 0; }
+
+    // Number of entries in the view
+    size_t size(const ScoreFilter& filter) const {
+        Query query;
+        if (!resolve(filter, query)) {
+            return 0;
+        }
+        if (!query.scan) {
+            return query.count;
+        }
+        size_t total = 0;
+        for (uint64_t i = 0; i < query.count; i++) {
+            total += matches(query, row(query.ids[i]));
+        }
+        return total;
+    }
+
+    // Number of entries in the view scoring at least `score`
+    size_t countAtLeast(const ScoreFilter& filter, int score) const {
+        return count(filter, score, true);
+    }
+
+    // 1-based rank of a score in the view, with equal scores sharing a rank
+    size_t rankOf(const ScoreFilter& filter, int score) const {
+        return count(filter, score, false) + 1;
+    }
+
+    // Ranking score (negative scores as zero) of the entry at 0-based `position` in the view
+    int scoreAt(const ScoreFilter& filter, size_t position) const {
+        Query query;
+        if (!resolve(filter, query)) {
+            return 0;
+        }
+        uint64_t index = query.scan ? nthMatch(query, position) : position;
+        return index < query.count ? rankScore(row(query.ids[index]).score) : 0;
+    }
+
+    // Up to `count` entries of the view starting at 0-based `position`, in ranking order
+    std::vector<ScoreEntry> range(const ScoreFilter& filter, size_t position, size_t count) const {
+        std::vector<ScoreEntry> result;
+        Query query;
+        if (!resolve(filter, query)) {
+            return result;
+        }
+        uint64_t index = query.scan ? nthMatch(query, position) : position;
+        for (; index < query.count && result.size() < count; index++) {
+            const Row& entry = row(query.ids[index]);
+            if (!query.scan || matches(query, entry)) {
+                result.push_back(entryOf(entry));
+            }
+        }
+        return result;
+    }
+
+    std::vector<std::string> getGames() const {
+        std::vector<std::string> result;
+        for (uint32_t id = 0; header && id < header->gameCount; id++) {
+            result.push_back(std::string(stringAt(header->nameCount + header->difficultyCount + id)));
+        }
+        return result;
+    }
+
+    bool hasGame(const std::string& game) const {
+        uint8_t id;
+        return findGame(game, id);
+    }
+
+    std::vector<std::string> getDifficulties(const std::string& game) const {
+        std::vector<std::string> result;
+        uint8_t gameId;
+        if (!findGame(game, gameId)) {
+            return result;
+        }
+        for (uint32_t i = 0; i < header->viewCount; i++) {
+            const View& view = views[i];
+            if (view.game == gameId && view.difficulty != ANY_DIFFICULTY && view.obstacles == ANY_OBSTACLES) {
+                result.push_back(std::string(stringAt(header->nameCount + view.difficulty)));
+            }
+        }
+        return result;
+    }
+
+    // Every entry in submission order
+    std::vector<ScoreEntry> entries() const {
+        std::vector<ScoreEntry> result;
+        result.reserve(size());
+        for (size_t id = 0; id < size(); id++) {
+            result.push_back(entryOf(rows[id]));
+        }
+        return result;
+    }
+
+    // Serializes `base` followed by `additions`, which were all submitted after it, leaving out
+    // scores of games past Leaderboard::MAX_GAMES.
+    // Runs in O(n log n) for the ranking sort and the new scores' names, and O(n) otherwise;
+    // meant for a background thread.
+    static std::string build(uint64_t generation, const MappedLeaderboard& base,
+                             const std::vector<ScoreEntry>& additions) {
+        // Difficulties and games are few; they are interned in order of first use
+        std::vector<std::string> difficulties;
+        std::vector<std::string> games;
+        std::unordered_map<std::string, uint32_t> difficultyIds;
+        std::unordered_map<std::string, uint32_t> gameIds;
+        std::string key;  // Reused, so known strings are looked up without allocating
+        auto intern = [&key](std::unordered_map<std::string, uint32_t>& ids, std::vector<std::string>& list,
+                             std::string_view text) {
+            key.assign(text.data(), text.size());
+            auto found = ids.find(key);
+            if (found != ids.end()) {
+                return found->second;
+            }
+            ids.emplace(key, uint32_t(list.size()));
+            list.push_back(key);
+            return uint32_t(list.size() - 1);
+        };
+
+        // Rows keep the base's name ids until names are merged below
+        uint32_t baseNameCount = base.isOpen() ? base.header->nameCount : 0;
+        bool damagedNames = false;
+        std::vector<Row> allRows;
+        allRows.reserve(base.size() + additions.size());
+        if (base.isOpen()) {
+            // Each of the base's strings is interned once, not once per row
+            const Header& old = *base.header;
+            std::vector<uint32_t> difficultyMap(old.difficultyCount, NO_ID);
+            std::vector<uint32_t> gameMap(old.gameCount, NO_ID);
+            auto remap = [&](std::vector<uint32_t>& map, std::unordered_map<std::string, uint32_t>& ids,
+                             std::vector<std::string>& list, uint32_t id, uint64_t first) {
+                if (id >= map.size()) {
+                    return intern(ids, list, std::string_view());  // Damaged; as stringAt would read it
+                }
+                if (map[id] == NO_ID) {
+                    map[id] = intern(ids, list, base.stringAt(first + id));
+                }
+                return map[id];
+            };
+            for (size_t id = 0; id < base.size(); id++) {
+                Row copy = base.rows[id];
+                damagedNames |= copy.name >= baseNameCount;
+                copy.difficulty = uint16_t(remap(difficultyMap, difficultyIds, difficulties, copy.difficulty,
+                                                 old.nameCount));
+                copy.game = uint8_t(remap(gameMap, gameIds, games, copy.game,
+                                          uint64_t(old.nameCount) + old.difficultyCount));
+                allRows.push_back(copy);
+            }
+        }
+        // Scores carry their game as a registry id, so each game is interned once
+        std::vector<uint32_t> gameOfId(size_t(GameRegistry::UNKNOWN) + 1, NO_ID);
+        std::vector<uint32_t> kept;  // Additions within the game limit
+        kept.reserve(additions.size());
+        for (size_t i = 0; i < additions.size(); i++) {
+            const ScoreEntry& entry = additions[i];
+            uint32_t& game = gameOfId[entry.getGameId()];
+            if (game == NO_ID) {
+                key.assign(entry.getGame().data(), entry.getGame().size());
+                if (games.size() == Leaderboard::MAX_GAMES && !gameIds.count(key)) {
+                    continue;  // Game ids are one byte, as in Leaderboard
+                }
+                game = intern(gameIds, games, entry.getGame());
+            }
+            Row added;
+            added.score = entry.getScore();
+            added.name = 0;
+            added.difficulty = uint16_t(intern(difficultyIds, difficulties, entry.getDifficultyName()));
+            added.game = uint8_t(game);
+            added.obstacles = entry.getHasObstacles() ? 1 : 0;
+            allRows.push_back(added);
+            kept.push_back(uint32_t(i));
+        }
+
+        // Names are sorted so lookups can binary-search them. The base's are sorted and distinct
+        // already, so only the new scores' names are sorted, then merged in; none is hashed.
+        // A name fits in 16 bytes; read big-endian and zero-padded, they compare as the name
+        // does, so the sort never follows a pointer to one.
+        static_assert(ScoreEntry::NAME_LENGTH <= 16, "names must fit the sort key");
+        struct NameKey {
+            uint64_t high;
+            uint64_t low;
+            uint32_t id;
+        };
+        std::vector<std::string_view> addedNames(additions.size());
+        std::vector<NameKey> nameKeys;
+        nameKeys.reserve(kept.size());
+        for (uint32_t i : kept) {
+            addedNames[i] = additions[i].getPlayerName();
+            NameKey nameKey = {0, 0, i};
+            for (size_t k = 0; k < 16; k++) {
+                uint64_t& half = k < 8 ? nameKey.high : nameKey.low;
+                half = (half << 8) | (k < addedNames[i].size() ? uint8_t(addedNames[i][k]) : 0);
+            }
+            nameKeys.push_back(nameKey);
+        }
+        std::sort(nameKeys.begin(), nameKeys.end(), [](const NameKey& a, const NameKey& b) {
+            return a.high != b.high ? a.high < b.high : a.low < b.low;
+        });
+        std::vector<uint32_t> newNames(nameKeys.size());
+        for (size_t i = 0; i < nameKeys.size(); i++) {
+            newNames[i] = nameKeys[i].id;
+        }
+        std::vector<std::string_view> names;
+        std::vector<uint32_t> baseNameIds(baseNameCount);
+        std::vector<uint32_t> newNameIds(additions.size());
+        if (damagedNames) {
+            names.push_back(std::string_view());  // Rows with a name id out of range read it as empty
+        }
+        for (size_t i = 0, j = 0; i < baseNameCount || j < newNames.size();) {
+            bool fromBase = j == newNames.size() ||
+                            (i < baseNameCount && base.stringAt(i) <= addedNames[newNames[j]]);
+            std::string_view name = fromBase ? base.stringAt(i) : addedNames[newNames[j]];
+            if (names.empty() || names.back() != name) {
+                names.push_back(name);
+            }
+            uint32_t id = uint32_t(names.size() - 1);
+            if (fromBase) {
+                baseNameIds[i++] = id;
+            } else {
+                newNameIds[newNames[j++]] = id;
+            }
+        }
+        for (size_t id = 0; id < base.size(); id++) {
+            allRows[id].name = allRows[id].name < baseNameCount ? baseNameIds[allRows[id].name] : 0;
+        }
+        for (size_t i = 0; i < kept.size(); i++) {
+            allRows[base.size() + i].name = newNameIds[kept[i]];
+        }
+
+        // One ranking sort, on keys holding the inverted ranking score above the row id; every
+        // view and player list is a subsequence of it
+        std::vector<uint64_t> keys(allRows.size());
+        for (size_t id = 0; id < allRows.size(); id++) {
+            keys[id] = (uint64_t(uint32_t(INT32_MAX - rankScore(allRows[id].score))) << 32) | id;
+        }
+        std::sort(keys.begin(), keys.end());
+        std::vector<uint32_t> ranking(allRows.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+            ranking[i] = uint32_t(keys[i]);
+        }
+        keys.clear();
+        keys.shrink_to_fit();
+
+        // Views: each mode (game, difficulty, obstacles) is looked up once and feeds four views,
+        // whose ids are then placed by counting, in view key order
+        std::unordered_map<uint64_t, uint32_t> modeIds;
+        std::vector<std::array<uint32_t, 4>> modeViews;
+        std::unordered_map<uint64_t, uint32_t> viewIds;
+        std::vector<uint64_t> viewKeys;
+        std::vector<uint32_t> rowModes(allRows.size());
+        for (size_t id = 0; id < allRows.size(); id++) {
+            const Row& entry = allRows[id];
+            auto mode = modeIds.emplace(viewKey(entry.game, entry.difficulty, entry.obstacles),
+                                        uint32_t(modeViews.size()));
+            if (mode.second) {
+                uint64_t keysOfMode[4] = {
+                    viewKey(entry.game, entry.difficulty, entry.obstacles),
+                    viewKey(entry.game, entry.difficulty, ANY_OBSTACLES),
+                    viewKey(entry.game, ANY_DIFFICULTY, entry.obstacles),
+                    viewKey(entry.game, ANY_DIFFICULTY, ANY_OBSTACLES)
+                };
+                std::array<uint32_t, 4> views;
+                for (int i = 0; i < 4; i++) {
+                    auto view = viewIds.emplace(keysOfMode[i], uint32_t(viewKeys.size()));
+                    if (view.second) {
+                        viewKeys.push_back(keysOfMode[i]);
+                    }
+                    views[i] = view.first->second;
+                }
+                modeViews.push_back(views);
+            }
+            rowModes[id] = mode.first->second;
+        }
+        std::vector<uint32_t> viewOrder(viewKeys.size());
+        std::iota(viewOrder.begin(), viewOrder.end(), 0);
+        std::sort(viewOrder.begin(), viewOrder.end(),
+            [&viewKeys](uint32_t a, uint32_t b) { return viewKeys[a] < viewKeys[b]; });
+        std::vector<uint64_t> viewFirst(viewKeys.size() + 1, 0);
+        std::vector<uint64_t> viewCount(viewKeys.size(), 0);
+        for (uint32_t mode : rowModes) {
+            for (uint32_t view : modeViews[mode]) {
+                viewCount[view]++;
+            }
+        }
+        uint64_t first = 0;
+        for (uint32_t view : viewOrder) {
+            viewFirst[view] = first;
+            first += viewCount[view];
+        }
+        std::vector<uint32_t> viewRows(static_cast<size_t>(first));
+        std::vector<uint64_t> viewNext(viewFirst.begin(), viewFirst.end() - 1);
+        for (uint32_t id : ranking) {
+            for (uint32_t view : modeViews[rowModes[id]]) {
+                viewRows[size_t(viewNext[view]++)] = id;
+            }
+        }
+
+        // Player lists: the ranking stably sorted by name, then by game, keeps ranking order
+        // within each player and orders players by game and name
+        std::vector<uint32_t> playerRows = sortByKey(ranking, names.size(),
+            [&allRows](uint32_t id) { return allRows[id].name; });
+        playerRows = sortByKey(playerRows, games.size(), [&allRows](uint32_t id) { return allRows[id].game; });
+        std::vector<uint64_t> playerKeys;
+        std::vector<uint64_t> playerFirst;
+        for (size_t i = 0; i < playerRows.size(); i++) {
+            const Row& entry = allRows[playerRows[i]];
+            uint64_t key = playerKey(entry.game, entry.name);
+            if (playerKeys.empty() || playerKeys.back() != key) {
+                playerKeys.push_back(key);
+                playerFirst.push_back(i);
+            }
+        }
+        playerFirst.push_back(playerRows.size());
+
+        // Lay out the sections
+        std::vector<std::string_view> allStrings(names);
+        allStrings.insert(allStrings.end(), difficulties.begin(), difficulties.end());
+        allStrings.insert(allStrings.end(), games.begin(), games.end());
+        size_t stringBytes = 0;
+        for (std::string_view text : allStrings) {
+            stringBytes += text.size();
+        }
+
+        Header head;
+        std::memset(&head, 0, sizeof(head));
+        std::memcpy(head.magic, "HSB1", 4);
+        head.version = VERSION;
+        head.generation = generation;
+        head.rowCount = allRows.size();
+        head.nameCount = uint32_t(names.size());
+        head.difficultyCount = uint32_t(difficulties.size());
+        head.gameCount = uint32_t(games.size());
+        head.viewCount = uint32_t(viewKeys.size());
+        head.playerCount = playerKeys.size();
+        head.idCount = viewRows.size() + playerRows.size();
+        head.rowsOffset = align(sizeof(Header));
+        head.stringOffsetsOffset = align(head.rowsOffset + allRows.size() * sizeof(Row));
+        head.stringsOffset = head.stringOffsetsOffset + (allStrings.size() + 1) * sizeof(uint32_t);
+        head.viewsOffset = align(head.stringsOffset + stringBytes);
+        head.playersOffset = head.viewsOffset + viewKeys.size() * sizeof(View);
+        head.idsOffset = head.playersOffset + playerKeys.size() * sizeof(Player);
+        head.fileSize = head.idsOffset + head.idCount * sizeof(uint32_t);
+
+        std::string bytes(size_t(head.fileSize), '\0');
+        char* out = &bytes[0];
+        std::memcpy(out, &head, sizeof(head));
+        if (!allRows.empty()) {
+            std::memcpy(out + head.rowsOffset, allRows.data(), allRows.size() * sizeof(Row));
+        }
+
+        uint32_t offset = 0;
+        for (size_t i = 0; i < allStrings.size(); i++) {
+            std::memcpy(out + head.stringOffsetsOffset + i * sizeof(uint32_t), &offset, sizeof(offset));
+            std::memcpy(out + head.stringsOffset + offset, allStrings[i].data(), allStrings[i].size());
+            offset += uint32_t(allStrings[i].size());
+        }
+        std::memcpy(out + head.stringOffsetsOffset + allStrings.size() * sizeof(uint32_t), &offset, sizeof(offset));
+
+        for (size_t i = 0; i < viewOrder.size(); i++) {
+            uint32_t id = viewOrder[i];
+            View view;
+            std::memset(&view, 0, sizeof(view));
+            view.game = uint8_t(viewKeys[id] >> 24);
+            view.difficulty = uint16_t(viewKeys[id] >> 8);
+            view.obstacles = uint8_t(viewKeys[id]);
+            view.first = viewFirst[id];
+            view.count = viewCount[id];
+            std::memcpy(out + head.viewsOffset + i * sizeof(View), &view, sizeof(view));
+        }
+        for (size_t i = 0; i < playerKeys.size(); i++) {
+            Player player;
+            std::memset(&player, 0, sizeof(player));
+            player.game = uint8_t(playerKeys[i] >> 32);
+            player.name = uint32_t(playerKeys[i]);
+            player.first = viewRows.size() + playerFirst[i];
+            player.count = playerFirst[i + 1] - playerFirst[i];
+            std::memcpy(out + head.playersOffset + i * sizeof(Player), &player, sizeof(player));
+        }
+        if (!viewRows.empty()) {
+            std::memcpy(out + head.idsOffset, viewRows.data(), viewRows.size() * sizeof(uint32_t));
+            std::memcpy(out + head.idsOffset + viewRows.size() * sizeof(uint32_t), playerRows.data(),
+                        playerRows.size() * sizeof(uint32_t));
+        }
+        return bytes;
+    }
+
+private:
+    // A filter resolved to a run of ids; player lists with further filters are scanned
+    struct Query {
+        const uint32_t* ids = nullptr;
+        uint64_t count = 0;
+        bool scan = false;
+        uint16_t difficulty = ANY_DIFFICULTY;
+        uint8_t obstacles = ANY_OBSTACLES;
+    };
+
+    static uint64_t align(uint64_t offset) {
+        return (offset + 7) & ~uint64_t(7);
+    }
+
+    // Stable counting sort of row ids by a key below `keyCount`
+    template <typename Key>
+    static std::vector<uint32_t> sortByKey(const std::vector<uint32_t>& ids, size_t keyCount, Key key) {
+        std::vector<size_t> next(keyCount + 1, 0);
+        for (uint32_t id : ids) {
+            next[key(id) + 1]++;
+        }
+        for (size_t i = 1; i <= keyCount; i++) {
+            next[i] += next[i - 1];
+        }
+        std::vector<uint32_t> sorted(ids.size());
+        for (uint32_t id : ids) {
+            sorted[next[key(id)]++] = id;
+        }
+        return sorted;
+    }
+
+    static int rankScore(int score) {
+        return score > 0 ? score : 0;
+    }
+
+    static uint64_t viewKey(uint8_t game, uint16_t difficulty, uint8_t obstacles) {
+        return (uint64_t(game) << 24) | (uint64_t(difficulty) << 8) | obstacles;
+    }
+
+    static uint64_t playerKey(uint8_t game, uint32_t name) {
+        return (uint64_t(game) << 32) | name;
+    }
+
+    // Checks every section lies inside the file, without reading the sections themselves
+    bool sectionsFit(const Header& head) const {
+        uint64_t stringCount = uint64_t(head.nameCount) + head.difficultyCount + head.gameCount;
+        return head.rowsOffset >= sizeof(Header) &&
+               head.rowsOffset + head.rowCount * sizeof(Row) <= head.stringOffsetsOffset &&
+               head.stringOffsetsOffset + (stringCount + 1) * sizeof(uint32_t) <= head.stringsOffset &&
+               head.stringsOffset <= head.viewsOffset &&
+               head.viewsOffset + uint64_t(head.viewCount) * sizeof(View) <= head.playersOffset &&
+               head.playersOffset + head.playerCount * sizeof(Player) <= head.idsOffset &&
+               head.idsOffset + head.idCount * sizeof(uint32_t) <= head.fileSize &&
+               head.rowsOffset % 8 == 0 && head.stringOffsetsOffset % 4 == 0 &&
+               head.viewsOffset % 8 == 0 && head.gameCount <= 256;
+    }
+
+    // Bounds-checked, so a damaged file yields wrong answers rather than stray reads
+    const Row& row(uint32_t id) const {
+        static const Row empty = {0, 0, 0, 0, 0};
+        return id < header->rowCount ? rows[id] : empty;
+    }
+
+    std::string_view stringAt(uint64_t id) const {
+        uint64_t stringCount = uint64_t(header->nameCount) + header->difficultyCount + header->gameCount;
+        if (id >= stringCount) {
+            return std::string_view();
+        }
+        uint32_t begin = stringOffsets[id];
+        uint32_t end = stringOffsets[id + 1];
+        if (begin > end || header->stringsOffset + end > header->viewsOffset) {
+            return std::string_view();
+        }
+        return std::string_view(strings + begin, end - begin);
+    }
+
+    ScoreEntry entryOf(const Row& entry) const {
+        return ScoreEntry(stringAt(header->nameCount + header->difficultyCount + entry.game),
+                          stringAt(entry.name), entry.score,
+                          stringAt(header->nameCount + entry.difficulty), entry.obstacles != 0);
+    }
+
+    bool findGame(const std::string& game, uint8_t& id) const {
+        for (uint32_t i = 0; header && i < header->gameCount; i++) {
+            if (stringAt(header->nameCount + header->difficultyCount + i) == game) {
+                id = uint8_t(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool findDifficulty(const std::string& difficulty, uint16_t& id) const {
+        for (uint32_t i = 0; i < header->difficultyCount; i++) {
+            if (stringAt(header->nameCount + i) == difficulty) {
+                id = uint16_t(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool findName(const std::string& name, uint32_t& id) const {
+        uint32_t low = 0;
+        uint32_t high = header->nameCount;
+        while (low < high) {
+            uint32_t middle = low + (high - low) / 2;
+            if (stringAt(middle) < name) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        id = low;
+        return low < header->nameCount && stringAt(low) == name;
+    }
+
+    bool resolve(const ScoreFilter& filter, Query& query) const {
+        uint8_t game;
+        if (!findGame(filter.game, game)) {
+            return false;
+        }
+        if (!filter.difficulty.empty() && !findDifficulty(filter.difficulty, query.difficulty)) {
+            return false;
+        }
+        query.obstacles = filter.obstacles == ScoreFilter::Obstacles::Any ? ANY_OBSTACLES
+                        : filter.obstacles == ScoreFilter::Obstacles::With ? 1 : 0;
+
+        uint64_t first;
+        if (!filter.player.empty()) {
+            uint32_t name;
+            if (!findName(filter.player, name)) {
+                return false;
+            }
+            uint64_t key = playerKey(game, name);
+            const Player* end = players + header->playerCount;
+            const Player* found = std::lower_bound(players, end, key,
+                [](const Player& player, uint64_t wanted) { return playerKey(player.game, player.name) < wanted; });
+            if (found == end || playerKey(found->game, found->name) != key) {
+                return false;
+            }
+            first = found->first;
+            query.count = found->count;
+            query.scan = query.difficulty != ANY_DIFFICULTY || query.obstacles != ANY_OBSTACLES;
+        } else {
+            uint64_t key = viewKey(game, query.difficulty, query.obstacles);
+            const View* end = views + header->viewCount;
+            const View* found = std::lower_bound(views, end, key,
+                [](const View& view, uint64_t wanted) { return viewKey(view.game, view.difficulty, view.obstacles) < wanted; });
+            if (found == end || viewKey(found->game, found->difficulty, found->obstacles) != key) {
+                return false;
+            }
+            first = found->first;
+            query.count = found->count;
+        }
+        if (first > header->idCount || query.count > header->idCount - first) {
+            return false;
+        }
+        query.ids = ids + first;
+        return true;
+    }
+
+    static bool matches(const Query& query, const Row& entry) {
+        return (query.difficulty == ANY_DIFFICULTY || entry.difficulty == query.difficulty) &&
+               (query.obstacles == ANY_OBSTACLES || entry.obstacles == query.obstacles);
+    }
+
+    // Index into query.ids of the view's entry at `position`, or query.count
+    uint64_t nthMatch(const Query& query, size_t position) const {
+        for (uint64_t i = 0; i < query.count; i++) {
+            if (matches(query, row(query.ids[i])) && position-- == 0) {
+                return i;
+            }
+        }
+        return query.count;
+    }
+
+    // Entries of the view scoring more than `score`, or as much with `inclusive`
+    size_t count(const ScoreFilter& filter, int score, bool inclusive) const {
+        Query query;
+        if (!resolve(filter, query)) {
+            return 0;
+        }
+        int wanted = rankScore(score);
+        auto before = [&](uint32_t id) {
+            int value = rankScore(row(id).score);
+            return inclusive ? value >= wanted : value > wanted;
+        };
+        if (query.scan) {
+            size_t total = 0;
+            for (uint64_t i = 0; i < query.count && before(query.ids[i]); i++) {
+                total += matches(query, row(query.ids[i]));
+            }
+            return total;
+        }
+        return size_t(std::partition_point(query.ids, query.ids + query.count, before) - query.ids);
+    }
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "ScoreEntry.hpp"
+
+// Typing rules shared by every player name prompt: printable ASCII up to MAX_LENGTH
+// characters, Backspace deletes, Enter confirms and an empty name becomes DEFAULT_NAME.
+class PlayerNameInput {
+public:
+    static const size_t MAX_LENGTH = ScoreEntry::NAME_LENGTH - 1;
+    static constexpr const char* DEFAULT_NAME = "Player";
+
+    enum class Result { Unchanged, Edited, Entered };
+
+    // Applies one character of a TextEntered event to `name`
+    static Result apply(std::string& name, uint32_t unicode) {
+        if (unicode == '\r' || unicode == '\n') {
+            if (name.empty()) {
+                name = DEFAULT_NAME;
+            }
+            return Result::Entered;
+        }
+        if (unicode == '\b') {
+            if (name.empty()) {
+                return Result::Unchanged;
+            }
+            name.pop_back();
+            return Result::Edited;
+        }
+        if (name.length() < MAX_LENGTH && unicode >= 32 && unicode < 127) {
+            name += static_cast<char>(unicode);
+            return Result::Edited;
+        }
+        return Result::Unchanged;
+    }
+};
@@ -0,0 +1,347 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "FileLock.hpp"
+#include "PlayerNameInput.hpp"
+#include "ScoreEntry.hpp"
+
+// How a finished game went for the player; None for games without an opponent, like Snake
+enum class GameResult { None, Win, Loss, Draw };
+
+// Per-player statistics across every game in the console, keyed by the name the player
+// entered. Each finished game updates a handful of counters, so nothing is ever recomputed
+// from history, and a name is found through a hash index, so any player's profile is ready
+// as soon as it is asked for.
+//
+// File layout (native endianness): Header, then one Record per player, game and difficulty,
+// in order of first play. The whole file is read once at startup, and a finished game
+// rewrites only its own record in place, like RPSModelStore does.
+// Several consoles may share the file. A finished game takes its lock, reads the records
+// others appended since, re-reads its own record and only then writes, so no console
+// overwrites another's records or counts. refresh() catches up with the others' games
+// before showing statistics.
+class PlayerProfiles {
+public:
+    static constexpr size_t NAME_LENGTH = ScoreEntry::NAME_LENGTH;
+    static constexpr size_t GAME_LENGTH = ScoreEntry::GAME_LENGTH;
+
+    struct Stats {
+        uint32_t played = 0;
+        uint32_t scored = 0;  // Games that ended with a score
+        uint32_t wins = 0;
+        uint32_t losses = 0;
+        uint32_t draws = 0;
+        int32_t bestScore = 0;
+        int64_t scoreTotal = 0;
+
+        double averageScore() const { return scored > 0 ? double(scoreTotal) / scored : 0.0; }
+
+        void add(GameResult result, int score, bool hasScore) {
+            played++;
+            if (hasScore) {
+                bestScore = scored == 0 ? score : std::max(bestScore, int32_t(score));
+                scored++;
+                scoreTotal += score;
+            }
+            wins += result == GameResult::Win;
+            losses += result == GameResult::Loss;
+            draws += result == GameResult::Draw;
+        }
+    };
+
+    // One game and difficulty of a player
+    struct Mode {
+        std::string game;
+        ScoreDifficulty difficulty;
+        Stats stats;
+        size_t record;  // Its slot in the file
+    };
+
+    struct Profile {
+        std::string name;
+        Stats totals;  // Over every mode; its best and average mix scores of different games
+        std::vector<Mode> modes;
+    };
+
+private:
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t recordSize;
+        uint32_t reserved;
+    };
+
+    struct Record {
+        char name[NAME_LENGTH];  // Padded like ScoreEntry's fields
+        char game[GAME_LENGTH];
+        int64_t scoreTotal;
+        int32_t bestScore;
+        uint32_t played;
+        uint32_t scored;
+        uint32_t wins;
+        uint32_t losses;
+        uint32_t draws;
+        uint8_t difficulty;
+        uint8_t reserved[7];
+    };
+
+    static_assert(sizeof(Record) == 88, "Record is stored as plain bytes");
+
+    static const uint32_t VERSION = 1;
+
+    const std::string filename;
+    const std::string lockPath;
+    std::fstream file;
+    size_t recordCount;
+    std::vector<Profile> profiles;
+    std::unordered_map<std::string, size_t> index;  // Name to position in profiles
+    std::string currentPlayer;
+    bool namedPlayer;  // Someone entered a name since startup
+
+public:
+    explicit PlayerProfiles(const std::string& fileName = "player_profiles.bin")
+        : filename(fileName), lockPath(fileName + ".lock"), recordCount(0),
+          currentPlayer(PlayerNameInput::DEFAULT_NAME), namedPlayer(false) {
+        load();
+    }
+
+    // The profiles shared by every game in the console
+    static PlayerProfiles& standard() {
+        static PlayerProfiles playerProfiles;
+        return playerProfiles;
+    }
+
+    // The name games record under until someone enters another one
+    void setCurrentPlayer(const std::string& name) {
+        if (!name.empty()) {
+            currentPlayer = name.substr(0, NAME_LENGTH);
+            namedPlayer = true;
+        }
+    }
+
+    const std::string& getCurrentPlayer() const { return currentPlayer; }
+
+    // False while games would still be recorded under the default name
+    bool hasCurrentPlayer() const { return namedPlayer; }
+
+    // Adds a finished game of the current player
+    void recordGame(std::string_view game, ScoreDifficulty difficulty, GameResult result) {
+        addGame(game, difficulty, result, 0, false);
+    }
+
+    void recordGame(std::string_view game, ScoreDifficulty difficulty, GameResult result, int score) {
+        addGame(game, difficulty, result, score, true);
+    }
+
+    // Catches up with games finished on other consoles: the records they appended, and the
+    // counts they rewrote in place in records read earlier
+    void refresh() {
+        FileLock lock(lockPath, false);
+        if (!file.is_open()) {
+            return;
+        }
+        std::vector<Record> records(recordCount);
+        file.clear();
+        file.seekg(std::streamoff(sizeof(Header)));
+        file.read(reinterpret_cast<char*>(records.data()), std::streamsize(records.size() * sizeof(Record)));
+        size_t read = size_t(file.gcount()) / sizeof(Record);
+        file.clear();
+        for (auto& profile : profiles) {
+            for (auto& mode : profile.modes) {
+                if (mode.record < read && isRecordOf(records[mode.record], profile.name, mode)) {
+                    mode.stats = statsOf(records[mode.record]);
+                }
+            }
+            sumModes(profile);
+        }
+        readNewRecords();
+    }
+
+    // Null if the player has not finished a game yet
+    const Profile* find(const std::string& name) const {
+        auto found = index.find(name.substr(0, NAME_LENGTH));
+        return found == index.end() ? nullptr : &profiles[found->second];
+    }
+
+    std::vector<std::string> getPlayerNames() const {
+        std::vector<std::string> names;
+        names.reserve(profiles.size());
+        for (const auto& profile : profiles) {
+            names.push_back(profile.name);
+        }
+        std::sort(names.begin(), names.end());
+        return names;
+    }
+
+    size_t getPlayerCount() const { return profiles.size(); }
+
+private:
+    void addGame(std::string_view game, ScoreDifficulty difficulty, GameResult result, int score, bool hasScore) {
+        game = game.substr(0, GAME_LENGTH);
+        FileLock lock(lockPath, true);
+        readNewRecords();
+        Profile& profile = profileOf(currentPlayer);
+
+        // A player has a few modes at most, one per game and difficulty played
+        Mode* mode = nullptr;
+        for (auto& candidate : profile.modes) {
+            if (candidate.difficulty == difficulty && candidate.game == game) {
+                mode = &candidate;
+                break;
+            }
+        }
+        if (!mode) {
+            profile.modes.push_back(Mode{std::string(game), difficulty, Stats(), recordCount++});
+            mode = &profile.modes.back();
+        } else {
+            rereadStats(profile.name, *mode);  // Another console may have played it since
+        }
+        mode->stats.add(result, score, hasScore);
+        sumModes(profile);
+        save(profile.name, *mode);
+    }
+
+    Profile& profileOf(const std::string& name) {
+        auto found = index.find(name);
+        if (found != index.end()) {
+            return profiles[found->second];
+        }
+        index.emplace(name, profiles.size());
+        profiles.push_back(Profile{name, Stats(), {}});
+        return profiles.back();
+    }
+
+    void load() {
+        FileLock lock(lockPath, true);
+        if (openFile()) {
+            readNewRecords();
+        }
+    }
+
+    // Adds the records appended since the last read, by this or another console
+    void readNewRecords() {
+        if (!file.is_open()) {
+            return;
+        }
+        file.clear();
+        file.seekg(std::streamoff(sizeof(Header) + recordCount * sizeof(Record)));
+        Record record;
+        while (file.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+            Profile& profile = profileOf(std::string(ScoreEntry::text(record.name, NAME_LENGTH)));
+            profile.modes.push_back(Mode{std::string(ScoreEntry::text(record.game, GAME_LENGTH)),
+                                         ScoreDifficulty(record.difficulty), statsOf(record), recordCount++});
+            merge(profile.totals, profile.modes.back().stats);
+        }
+        file.clear();  // A partly written last record is overwritten by the next new one
+    }
+
+    // Takes the mode's counts from its record on disk
+    void rereadStats(const std::string& name, Mode& mode) {
+        Record record;
+        file.clear();
+        file.seekg(std::streamoff(sizeof(Header) + mode.record * sizeof(Record)));
+        if (file.read(reinterpret_cast<char*>(&record), sizeof(record)) && isRecordOf(record, name, mode)) {
+            mode.stats = statsOf(record);
+        }
+        file.clear();
+    }
+
+    static bool isRecordOf(const Record& record, const std::string& name, const Mode& mode) {
+        return ScoreEntry::text(record.name, NAME_LENGTH) == name &&
+               ScoreEntry::text(record.game, GAME_LENGTH) == mode.game &&
+               ScoreDifficulty(record.difficulty) == mode.difficulty;
+    }
+
+    static Stats statsOf(const Record& record) {
+        Stats stats;
+        stats.played = record.played;
+        stats.scored = record.scored;
+        stats.wins = record.wins;
+        stats.losses = record.losses;
+        stats.draws = record.draws;
+        stats.bestScore = record.bestScore;
+        stats.scoreTotal = record.scoreTotal;
+        return stats;
+    }
+
+    static void sumModes(Profile& profile) {
+        profile.totals = Stats();
+        for (const auto& mode : profile.modes) {
+            merge(profile.totals, mode.stats);
+        }
+    }
+
+    static void merge(Stats& totals, const Stats& stats) {
+        if (stats.scored > 0) {
+            totals.bestScore = totals.scored == 0 ? stats.bestScore : std::max(totals.bestScore, stats.bestScore);
+        }
+        totals.played += stats.played;
+        totals.scored += stats.scored;
+        totals.wins += stats.wins;
+        totals.losses += stats.losses;
+        totals.draws += stats.draws;
+        totals.scoreTotal += stats.scoreTotal;
+    }
+
+    // Rewrites the mode's record, or appends it if new
+    void save(const std::string& name, const Mode& mode) {
+        if (!file.is_open()) {
+            return;
+        }
+        Record record;
+        std::memset(&record, 0, sizeof(record));
+        ScoreEntry::setText(record.name, NAME_LENGTH, name);
+        ScoreEntry::setText(record.game, GAME_LENGTH, mode.game);
+        record.scoreTotal = mode.stats.scoreTotal;
+        record.bestScore = mode.stats.bestScore;
+        record.played = mode.stats.played;
+        record.scored = mode.stats.scored;
+        record.wins = mode.stats.wins;
+        record.losses = mode.stats.losses;
+        record.draws = mode.stats.draws;
+        record.difficulty = uint8_t(mode.difficulty);
+
+        file.clear();
+        file.seekp(std::streamoff(sizeof(Header) + mode.record * sizeof(Record)));
+        file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        file.flush();
+    }
+
+    bool openFile() {
+        file.open(filename, std::ios::in | std::ios::out | std::ios::binary);
+        if (!file.is_open()) {
+            // Create it with just a header
+            std::ofstream create(filename, std::ios::binary);
+            Header header = makeHeader();
+            create.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            create.close();
+            file.open(filename, std::ios::in | std::ios::out | std::ios::binary);
+            return file.is_open();
+        }
+
+        Header header;
+        Header expected = makeHeader();
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(&header, &expected, sizeof(header)) != 0) {
+            file.close();  // Someone else's file, or another format; leave it alone
+            return false;
+        }
+        return true;
+    }
+
+    static Header makeHeader() {
+        Header header;
+        std::memcpy(header.magic, "PPRF", 4);
+        header.version = VERSION;
+        header.recordSize = sizeof(Record);
+        header.reserved = 0;
+        return header;
+    }
+};
@@ -0,0 +1,201 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "FramePacer.hpp"
+#include "PlayerNameInput.hpp"
+#include "PlayerProfiles.hpp"
+
+// Shows one player's profile: totals, then a row per game and difficulty played. Typing a
+// name looks it up as it is typed; Tab steps through every known player.
+class PlayerStatsScreen {
+private:
+    static const unsigned MAX_ROWS = 12;
+    static const int COLUMN_COUNT = 6;
+
+    sf::RenderWindow& window;
+    sf::Font& font;
+    FramePacer pacer;
+    PlayerProfiles& profiles;
+    std::vector<std::string> playerNames;  // Sorted, for Tab
+    std::string playerName;
+    bool shouldExit;
+
+    // Built when the name changes, so drawing allocates nothing
+    sf::Text titleText;
+    sf::Text nameText;
+    sf::Text summaryText;
+    sf::Text helpText;
+    std::vector<sf::Text> headerTexts;
+    std::vector<sf::Text> cellTexts;
+
+public:
+    PlayerStatsScreen(sf::RenderWindow& gameWindow, sf::Font& gameFont)
+        : window(gameWindow), font(gameFont), pacer(gameWindow), profiles(PlayerProfiles::standard()),
+          playerName(profiles.getCurrentPlayer()), shouldExit(false) {
+        profiles.refresh();  // Other consoles may have finished games since
+        playerNames = profiles.getPlayerNames();
+        initializeTexts();
+        refreshView();
+    }
+
+    bool run() {
+        while (window.isOpen() && !shouldExit) {
+            handleEvents();
+            render();
+            if (!shouldExit) {
+                pacer.waitEvent();  // Nothing here changes without input
+            }
+        }
+        return true;
+    }
+
+private:
+    static float columnX(int column) {
+        static const float positions[COLUMN_COUNT] = {40.f, 340.f, 470.f, 550.f, 620.f, 710.f};
+        return positions[column];
+    }
+
+    void initializeTexts() {
+        titleText = sf::Text("Player Stats", font, 40);
+        titleText.setFillColor(sf::Color::White);
+        centerText(titleText, 30);
+
+        nameText = sf::Text("", font, 28);
+        nameText.setFillColor(sf::Color::Yellow);
+
+        summaryText = sf::Text("", font, 20);
+        summaryText.setFillColor(sf::Color::White);
+
+        helpText = sf::Text("Type a name - Tab: next player - Esc: back", font, 18);
+        helpText.setFillColor(sf::Color(180, 180, 180));
+        centerText(helpText, 560);
+
+        static const char* headers[COLUMN_COUNT] = {"Game", "Difficulty", "Played", "Best", "Average", "W-L-D"};
+        for (int i = 0; i < COLUMN_COUNT; i++) {
+            sf::Text text(headers[i], font, 18);
+            text.setFillColor(sf::Color(150, 200, 255));
+            text.setPosition(columnX(i), 200);
+            headerTexts.push_back(text);
+        }
+    }
+
+    void centerText(sf::Text& text, float y) {
+        text.setPosition((window.getSize().x - text.getGlobalBounds().width) / 2, y);
+    }
+
+    void handleEvents() {
+        sf::Event event;
+        while (pacer.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                window.close();
+            }
+            else if (event.type == sf::Event::KeyPressed) {
+                if (event.key.code == sf::Keyboard::Escape) {
+                    shouldExit = true;
+                }
+                else if (event.key.code == sf::Keyboard::Tab) {
+                    selectNextPlayer();
+                }
+            }
+            else if (event.type == sf::Event::TextEntered) {
+                handleNameInput(event.text.unicode);
+            }
+        }
+    }
+
+    void handleNameInput(sf::Uint32 unicode) {
+        if (PlayerNameInput::apply(playerName, unicode) != PlayerNameInput::Result::Unchanged) {
+            refreshView();
+        }
+    }
+
+    void selectNextPlayer() {
+        if (playerNames.empty()) {
+            return;
+        }
+        auto next = std::upper_bound(playerNames.begin(), playerNames.end(), playerName);
+        playerName = next == playerNames.end() ? playerNames.front() : *next;
+        refreshView();
+    }
+
+    static std::string formatRecord(const PlayerProfiles::Stats& stats) {
+        if (stats.wins + stats.losses + stats.draws == 0) {
+            return "-";
+        }
+        return std::to_string(stats.wins) + "-" + std::to_string(stats.losses) + "-" + std::to_string(stats.draws);
+    }
+
+    static std::string formatAverage(const PlayerProfiles::Stats& stats) {
+        if (stats.scored == 0) {
+            return "-";
+        }
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(1) << stats.averageScore();
+        return out.str();
+    }
+
+    void addCell(int column, float y, const std::string& value) {
+        sf::Text text(value, font, 18);
+        text.setFillColor(sf::Color::White);
+        text.setPosition(columnX(column), y);
+        cellTexts.push_back(text);
+    }
+
+    void refreshView() {
+        nameText.setString(playerName + "_");
+        centerText(nameText, 90);
+        cellTexts.clear();
+
+        const PlayerProfiles::Profile* profile = profiles.find(playerName);
+        if (!profile) {
+            summaryText.setString(playerName.empty() ? "" : "No games played yet");
+            centerText(summaryText, 145);
+            return;
+        }
+
+        const PlayerProfiles::Stats& totals = profile->totals;
+        summaryText.setString("Games: " + std::to_string(totals.played) + "   Wins: " + std::to_string(totals.wins) +
+                              "   Losses: " + std::to_string(totals.losses) +
+                              "   Draws: " + std::to_string(totals.draws));
+        centerText(summaryText, 145);
+
+        std::vector<const PlayerProfiles::Mode*> modes;
+        for (const auto& mode : profile->modes) {
+            modes.push_back(&mode);
+        }
+        std::sort(modes.begin(), modes.end(), [](const PlayerProfiles::Mode* a, const PlayerProfiles::Mode* b) {
+            return a->game != b->game ? a->game < b->game : a->difficulty < b->difficulty;
+        });
+
+        float y = 235;
+        for (size_t i = 0; i < modes.size() && i < MAX_ROWS; i++, y += 26) {
+            const PlayerProfiles::Stats& stats = modes[i]->stats;
+            std::string_view difficulty = ScoreEntry::difficultyName(modes[i]->difficulty);
+            addCell(0, y, modes[i]->game);
+            addCell(1, y, difficulty.empty() ? "-" : std::string(difficulty));
+            addCell(2, y, std::to_string(stats.played));
+            addCell(3, y, stats.scored > 0 ? std::to_string(stats.bestScore) : "-");
+            addCell(4, y, formatAverage(stats));
+            addCell(5, y, formatRecord(stats));
+        }
+    }
+
+    void render() {
+        window.clear(sf::Color(50, 50, 50));
+        window.draw(titleText);
+        window.draw(nameText);
+        window.draw(summaryText);
+        for (const auto& text : headerTexts) {
+            window.draw(text);
+        }
+        for (const auto& text : cellTexts) {
+            window.draw(text);
+        }
+        window.draw(helpText);
+        window.display();
+    }
+};
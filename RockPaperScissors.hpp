@@ -1,12 +1,32 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <algorithm>
 #include <random>
 #include <string>
-
-class RockPaperScissors {
+#include <vector>
+#include "FramePacer.hpp"
+#include "HighScore.hpp"
+#include "PlayerNameInput.hpp"
+#include "PlayerProfiles.hpp"
+#include "RockPaperScissorsAI.hpp"
+#include "RockPaperScissorsStore.hpp"
+#include "Tween.hpp"
+#include "VariantLauncher.hpp"
+
+// Played with any odd number of weapons; see RPSVariant in RockPaperScissorsCore.hpp
+template <int WEAPONS = 3>
+class BasicRockPaperScissors {
 private:
-    enum class Choice { None, Rock, Paper, Scissors };
-    enum class GameState { SelectRounds, Playing, RoundEnd, GameOver };
+    using Rules = BasicRPSRules<WEAPONS>;
+    using Variant = RPSVariant<WEAPONS>;
+    using Predictor = BasicRPSPredictor<WEAPONS>;
+    using Ensemble = BasicRPSEnsemble<WEAPONS>;
+
+    using Choice = int;  // Index into Variant::NAMES
+    static const Choice NO_CHOICE = -1;
+
+    enum class GameState { EnterName, SelectRounds, Playing, RoundEnd, GameOver };
+    enum class AIDifficulty { Easy, Medium, Hard };
     
     struct Button {
         sf::RectangleShape shape;
@@ -17,6 +37,7 @@ private:
     // Window and resources
     sf::RenderWindow& window;
     sf::Font& font;
+    FramePacer pacer;
     
     // Game state
     GameState currentState;
@@ -30,28 +51,62 @@ private:
     bool shouldExit;
 
     // UI Elements
-    Button rockButton;
-    Button paperButton;
-    Button scissorsButton;
+    Button choiceButtons[WEAPONS];
     Button roundButtons[3];  // Best of 3, 5, 7
+    Button difficultyButtons[3];  // Easy, Medium, Hard
     sf::Text scoreText;
     sf::Text resultText;
     sf::Text roundText;
 
+    // Built once, or when the state they show changes; render() only draws them
+    sf::Text titleText;
+    sf::Text difficultyTitle;
+    sf::Text promptText;
+    sf::Text playerChoiceText;
+    sf::Text computerChoiceText;
+    sf::Text drawText;
+    sf::Text gameOverText;
+    sf::Text finalScoreText;
+    sf::Color resultColor;
+    sf::Color gameOverColor;
+
+    // Computer player. Easy plays at random, Medium counters the move its pattern model
+    // expects next, Hard follows the strategy ensemble. Both models learn every round.
+    AIDifficulty aiDifficulty;
+    Predictor predictor;
+    Ensemble ensemble;
+    std::mt19937 rng;
+
+    // The computer remembers each player's recent rounds between sessions
+    std::string playerName;
+    RPSModelStore modelStore;
+    sf::Text nameText;
+    sf::Text memoryText;
+
+    // Consecutive rounds won, across matches; it goes on the leaderboard when it ends
+    int winStreak;
+
     sf::Clock gameClock;
     float roundEndTimer;
     float resultDisplayTimer;
     static constexpr float ROUND_END_DELAY = 2.0f;  // 2 seconds
     static constexpr float RESULT_DISPLAY_TIME = 1.5f;  // 1.5 seconds
+    static constexpr float MAX_FRAME_TIME = 0.1f;  // Clamp long stalls so transitions don't jump
+    static constexpr float SLIDE_DISTANCE = 40.f;
+    static constexpr float RESULT_Y = 150.f;
+    static constexpr float CHOICE_TEXT_X = 200.f;
+    static constexpr float GAME_OVER_Y = 200.f;
 
     // Add continue button to member variables
     Button continueButton;
 
 public:
-    RockPaperScissors(sf::RenderWindow& gameWindow, sf::Font& gameFont)
-        : window(gameWindow), font(gameFont), currentState(GameState::SelectRounds),
+    BasicRockPaperScissors(sf::RenderWindow& gameWindow, sf::Font& gameFont)
+        : window(gameWindow), font(gameFont), pacer(gameWindow), currentState(GameState::EnterName),
           playerScore(0), computerScore(0), targetScore(0), currentRound(1),
-          playerChoice(Choice::None), computerChoice(Choice::None), shouldExit(false) {
+          playerChoice(NO_CHOICE), computerChoice(NO_CHOICE), shouldExit(false),
+          aiDifficulty(AIDifficulty::Medium), rng(std::random_device{}()),
+          modelStore(modelFileName(), WEAPONS), winStreak(0), roundEndTimer(0.f), resultDisplayTimer(0.f) {
         initializeGame();
     }
 
@@ -60,7 +115,12 @@ public:
             handleEvents();
             updateGame();
             render();
+            if (!shouldExit && !isAnimating()) {
+                pacer.waitEvent();
+                gameClock.restart();  // Time spent waiting moves nothing
+            }
         }
+        recordStreak();
         return true;
     }
 
@@ -83,26 +143,28 @@ private:
         continueButton.shape.setFillColor(sf::Color(0, 150, 0));   // Green color
     }
 
+    // Up to five buttons per row, each row centred, all between the result and choice texts
     void setupChoiceButtons() {
-        const float buttonSize = 100.f;
-        const float spacing = 50.f;
-        const float startX = (window.getSize().x - (3 * buttonSize + 2 * spacing)) / 2;
-        const float startY = 250.f;
-
-        // Rock Button
-        setupButton(rockButton, "Rock", 
-                   sf::Vector2f(startX, startY),
-                   sf::Vector2f(buttonSize, buttonSize));
-
-        // Paper Button
-        setupButton(paperButton, "Paper", 
-                   sf::Vector2f(startX + buttonSize + spacing, startY),
-                   sf::Vector2f(buttonSize, buttonSize));
+        const int rows = (WEAPONS + 4) / 5;
+        const int columns = (WEAPONS + rows - 1) / rows;
+        const float spacing = columns <= 3 ? 50.f : 20.f;
+        const float buttonWidth = columns <= 3 ? 100.f : 130.f;
+        const float buttonHeight = rows == 1 ? 100.f : (170.f - (rows - 1) * spacing) / rows;
+        const float startY = rows == 1 ? 250.f : 215.f;
+
+        for (int i = 0; i < WEAPONS; i++) {
+            int row = i / columns;
+            int inRow = std::min(columns, WEAPONS - row * columns);
+            float startX = (window.getSize().x - (inRow * buttonWidth + (inRow - 1) * spacing)) / 2;
+            setupButton(choiceButtons[i], Variant::NAMES[i],
+                       sf::Vector2f(startX + (i % columns) * (buttonWidth + spacing),
+                                  startY + row * (buttonHeight + spacing)),
+                       sf::Vector2f(buttonWidth, buttonHeight));
+        }
+    }
 
-        // Scissors Button
-        setupButton(scissorsButton, "Scissors", 
-                   sf::Vector2f(startX + 2 * (buttonSize + spacing), startY),
-                   sf::Vector2f(buttonSize, buttonSize));
+    static std::string modelFileName() {
+        return WEAPONS == 3 ? "rps_models.bin" : "rps" + std::to_string(WEAPONS) + "_models.bin";
     }
 
     void setupRoundButtons() {
@@ -119,6 +181,31 @@ private:
                                   startY + i * (buttonHeight + spacing)),
                        sf::Vector2f(buttonWidth, buttonHeight));
         }
+
+        std::string difficultyNames[] = {"Easy", "Medium", "Hard"};
+        const float difficultyWidth = 150.f;
+        const float difficultyStartX = (window.getSize().x - (3 * difficultyWidth + 2 * spacing)) / 2;
+        for (int i = 0; i < 3; i++) {
+            setupButton(difficultyButtons[i], difficultyNames[i],
+                       sf::Vector2f(difficultyStartX + i * (difficultyWidth + spacing),
+                                  startY + 3 * (buttonHeight + spacing) + 40.f),
+                       sf::Vector2f(difficultyWidth, buttonHeight));
+        }
+        updateDifficultyColors();
+    }
+
+    void updateDifficultyColors() {
+        for (int i = 0; i < 3; i++) {
+            Button& button = difficultyButtons[i];
+            if (static_cast<int>(aiDifficulty) == i) {
+                button.shape.setFillColor(sf::Color(0, 120, 200));
+            }
+            else {
+                button.shape.setFillColor(
+                    button.isHovered ? sf::Color(150, 150, 150) : sf::Color(100, 100, 100)
+                );
+            }
+        }
     }
 
     void setupButton(Button& button, const std::string& text, 
@@ -153,23 +240,61 @@ private:
         resultText.setFont(font);
         resultText.setCharacterSize(40);
         resultText.setFillColor(sf::Color::White);
-        resultText.setPosition(
-            window.getSize().x / 2,
-            150.f
-        );
         
         // Round Text
         roundText.setFont(font);
         roundText.setCharacterSize(24);
         roundText.setFillColor(sf::Color::White);
         roundText.setPosition(20, 60);
-        
+
+        nameText.setFont(font);
+        nameText.setCharacterSize(30);
+        nameText.setFillColor(sf::Color::White);
+
+        memoryText.setFont(font);
+        memoryText.setCharacterSize(20);
+        memoryText.setFillColor(sf::Color(180, 180, 180));
+
+        setupCenteredText(titleText, "Select Number of Rounds", 40, 100);
+        setupCenteredText(difficultyTitle, "Computer", 24, difficultyButtons[0].shape.getPosition().y - 35);
+        setupCenteredText(promptText, "Enter your name:", 30, 200);
+        setupCenteredText(drawText, "Round will not count. Click to play again.", 24, 500);
+        drawText.setFillColor(sf::Color::Yellow);
+
+        playerChoiceText.setFont(font);
+        playerChoiceText.setCharacterSize(24);
+        computerChoiceText.setFont(font);
+        computerChoiceText.setCharacterSize(24);
+
+        gameOverText.setFont(font);
+        gameOverText.setCharacterSize(40);
+        finalScoreText.setFont(font);
+        finalScoreText.setCharacterSize(30);
+
+        updateNameText();
         updateScoreText();
     }
 
+    void setupCenteredText(sf::Text& text, const std::string& string, unsigned size, float y) {
+        text.setFont(font);
+        text.setString(string);
+        text.setCharacterSize(size);
+        text.setFillColor(sf::Color::White);
+        centerText(text, y);
+    }
+
+    void centerText(sf::Text& text, float y) {
+        text.setPosition((window.getSize().x - text.getGlobalBounds().width) / 2, y);
+    }
+
+    void updateNameText() {
+        nameText.setString(playerName + "_");
+        centerText(nameText, 260);
+    }
+
     void handleEvents() {
         sf::Event event;
-        while (window.pollEvent(event)) {
+        while (pacer.pollEvent(event)) {
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
@@ -187,13 +312,49 @@ private:
                     handleKeyPress(event.key);
                 }
             }
+            else if (event.type == sf::Event::TextEntered && currentState == GameState::EnterName) {
+                handleNameInput(event.text.unicode);
+            }
+        }
+    }
+
+    void handleNameInput(sf::Uint32 unicode) {
+        PlayerNameInput::Result result = PlayerNameInput::apply(playerName, unicode);
+        if (result == PlayerNameInput::Result::Entered) {
+            PlayerProfiles::standard().setCurrentPlayer(playerName);
+            loadPlayerModel();
+            currentState = GameState::SelectRounds;
+        }
+        else if (result == PlayerNameInput::Result::Edited) {
+            updateNameText();
         }
     }
 
+    // Replays the player's stored rounds so both computer models start warmed up
+    void loadPlayerModel() {
+        std::vector<RPSModelStore::Round> rounds = modelStore.load(playerName);
+        for (const auto& round : rounds) {
+            predictor.update(round.first, round.second);
+            ensemble.update(round.first, round.second);
+        }
+
+        if (modelStore.getRounds() > 0) {
+            memoryText.setString("Welcome back, " + playerName + "! The computer remembers your last " +
+                                 std::to_string(rounds.size()) + " rounds.");
+        }
+        else {
+            memoryText.setString("Welcome, " + playerName + "! The computer will learn how you play.");
+        }
+        centerText(memoryText, 160);
+    }
+
     void handleMouseClick(const sf::Event::MouseButtonEvent& mouseButton) {
         sf::Vector2f mousePos(mouseButton.x, mouseButton.y);
 
         switch (currentState) {
+            case GameState::EnterName:
+                break;
+
             case GameState::SelectRounds:
                 handleRoundSelection(mousePos);
                 break;
@@ -204,8 +365,8 @@ private:
             
             case GameState::RoundEnd:
                 currentState = GameState::Playing;
-                playerChoice = Choice::None;
-                computerChoice = Choice::None;
+                playerChoice = NO_CHOICE;
+                computerChoice = NO_CHOICE;
                 if (playerChoice != computerChoice) {  // Only increment round if it wasn't a draw
                     currentRound++;
                 }
@@ -222,6 +383,17 @@ private:
     }
 
     void handleRoundSelection(const sf::Vector2f& mousePos) {
+        for (int i = 0; i < 3; i++) {
+            if (checkButtonClick(mousePos, difficultyButtons[i])) {
+                if (static_cast<AIDifficulty>(i) != aiDifficulty) {
+                    recordStreak();  // Streaks are ranked per difficulty
+                }
+                aiDifficulty = static_cast<AIDifficulty>(i);
+                updateDifficultyColors();
+                return;
+            }
+        }
+
         for (int i = 0; i < 3; i++) {
             if (checkButtonClick(mousePos, roundButtons[i])) {
                 totalRounds = (i + 1) * 2 + 1;  // 3, 5, or 7
@@ -234,82 +406,144 @@ private:
     }
 
     void handleChoiceSelection(const sf::Vector2f& mousePos) {
-        if (playerChoice == Choice::None) {
-            if (checkButtonClick(mousePos, rockButton)) {
-                makeChoice(Choice::Rock);
+        if (playerChoice == NO_CHOICE) {
+            for (int i = 0; i < WEAPONS; i++) {
+                if (checkButtonClick(mousePos, choiceButtons[i])) {
+                    makeChoice(i);
+                    break;
+                }
+            }
+        }
+    }
+
+    // Number keys pick by position, letters by a weapon's unique initial (R, P, S in the classic game)
+    void handleKeyPress(const sf::Event::KeyEvent& keyEvent) {
+        if (currentState == GameState::Playing && playerChoice == NO_CHOICE) {
+            Choice choice = NO_CHOICE;
+            if (keyEvent.code >= sf::Keyboard::Num1 && keyEvent.code <= sf::Keyboard::Num9) {
+                int index = keyEvent.code - sf::Keyboard::Num1;
+                if (index < WEAPONS) {
+                    choice = index;
+                }
             }
-            else if (checkButtonClick(mousePos, paperButton)) {
-                makeChoice(Choice::Paper);
+            else if (keyEvent.code >= sf::Keyboard::A && keyEvent.code <= sf::Keyboard::Z) {
+                choice = choiceForInitial(static_cast<char>('A' + (keyEvent.code - sf::Keyboard::A)));
             }
-            else if (checkButtonClick(mousePos, scissorsButton)) {
-                makeChoice(Choice::Scissors);
+            if (choice != NO_CHOICE) {
+                makeChoice(choice);
             }
         }
     }
 
-    void handleKeyPress(const sf::Event::KeyEvent& keyEvent) {
-        if (currentState == GameState::Playing && playerChoice == Choice::None) {
-            switch (keyEvent.code) {
-                case sf::Keyboard::R:
-                    makeChoice(Choice::Rock);
-                    break;
-                case sf::Keyboard::P:
-                    makeChoice(Choice::Paper);
-                    break;
-                case sf::Keyboard::S:
-                    makeChoice(Choice::Scissors);
-                    break;
-                default:
-                    break;
+    static Choice choiceForInitial(char initial) {
+        Choice found = NO_CHOICE;
+        for (int i = 0; i < WEAPONS; i++) {
+            if (Variant::NAMES[i][0] == initial) {
+                if (found != NO_CHOICE) {
+                    return NO_CHOICE;  // Ambiguous
+                }
+                found = i;
             }
         }
+        return found;
     }
 
     void makeChoice(Choice choice) {
         playerChoice = choice;
-        computerChoice = getRandomChoice();
+        computerChoice = getComputerChoice();
+        predictor.update(playerChoice, computerChoice);
+        ensemble.update(playerChoice, computerChoice);
+        modelStore.append(playerChoice, computerChoice);
         determineRoundWinner();
+        updateChoiceTexts();
         roundEndTimer = ROUND_END_DELAY;
         resultDisplayTimer = RESULT_DISPLAY_TIME;
         currentState = GameState::RoundEnd;
+        updateTransitions();
+    }
+
+    void updateChoiceTexts() {
+        playerChoiceText.setString("Your choice: " + choiceToString(playerChoice));
+        computerChoiceText.setString("Computer's choice: " + choiceToString(computerChoice));
     }
 
-    Choice getRandomChoice() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        static std::uniform_int_distribution<> dis(1, 3);
-        return static_cast<Choice>(dis(gen));
+    Choice getComputerChoice() {
+        switch (aiDifficulty) {
+            case AIDifficulty::Easy:
+                return static_cast<Choice>(rng() % WEAPONS);
+            case AIDifficulty::Medium:
+                return Predictor::bestResponse(predictor.predict(), rng);
+            default:
+                return ensemble.chooseMove();
+        }
     }
 
     void determineRoundWinner() {
-        if (playerChoice == computerChoice) {
+        RPSOutcome outcome = Rules::judge(playerChoice, computerChoice);
+        if (outcome == RPSOutcome::Draw) {
             resultText.setString("Draw! Play again!");
-            resultText.setFillColor(sf::Color::Yellow);
+            resultColor = sf::Color::Yellow;
             currentRound--;  // Don't count this round
         }
-        else if ((playerChoice == Choice::Rock && computerChoice == Choice::Scissors) ||
-                 (playerChoice == Choice::Paper && computerChoice == Choice::Rock) ||
-                 (playerChoice == Choice::Scissors && computerChoice == Choice::Paper)) {
+        else if (outcome == RPSOutcome::FirstWins) {
             resultText.setString("You Win!");
-            resultText.setFillColor(sf::Color::Green);
+            resultColor = sf::Color::Green;
             playerScore++;
+            winStreak++;
         }
         else {
             resultText.setString("Computer Wins!");
-            resultText.setFillColor(sf::Color::Red);
+            resultColor = sf::Color::Red;
             computerScore++;
+            recordStreak();
         }
+        centerText(resultText, RESULT_Y);
 
         updateScoreText();
         
         if (playerScore >= targetScore || computerScore >= targetScore) {
             currentState = GameState::GameOver;
+            recordMatch();
+            updateGameOverTexts();
         }
         else {
             currentState = GameState::RoundEnd;
         }
     }
 
+    void recordStreak() {
+        if (winStreak > 0) {
+            static const char* difficultyNames[] = {"Easy", "Medium", "Hard"};
+            HighScoreManager::standard().addScore(Variant::TITLE, playerName, winStreak,
+                                                  difficultyNames[static_cast<int>(aiDifficulty)], false);
+        }
+        winStreak = 0;
+    }
+
+    // A finished match goes into the player's profile, scored by the rounds they won
+    void recordMatch() {
+        static const char* difficultyNames[] = {"Easy", "Medium", "Hard"};
+        ScoreDifficulty difficulty = ScoreEntry::difficultyFromName(difficultyNames[static_cast<int>(aiDifficulty)]);
+        GameResult result = playerScore > computerScore ? GameResult::Win : GameResult::Loss;
+        PlayerProfiles::standard().recordGame(Variant::TITLE, difficulty, result, playerScore);
+    }
+
+    void updateGameOverTexts() {
+        if (playerScore > computerScore) {
+            gameOverText.setString("Congratulations! You Won!");
+            gameOverColor = sf::Color::Green;
+        }
+        else {
+            gameOverText.setString("Game Over! Computer Wins!");
+            gameOverColor = sf::Color::Red;
+        }
+        centerText(gameOverText, GAME_OVER_Y);
+
+        finalScoreText.setString("Final Score: Player " + std::to_string(playerScore) + 
+                                " - Computer " + std::to_string(computerScore));
+        centerText(finalScoreText, 300);
+    }
+
     void updateScoreText() {
         scoreText.setString("Score - Player: " + std::to_string(playerScore) + 
                           " Computer: " + std::to_string(computerScore));
@@ -330,11 +564,15 @@ private:
             for (auto& button : roundButtons) {
                 updateButtonHover(button, mousePos);
             }
+            for (auto& button : difficultyButtons) {
+                button.isHovered = button.shape.getGlobalBounds().contains(mousePos);
+            }
+            updateDifficultyColors();
         }
         else if (currentState == GameState::Playing) {
-            updateButtonHover(rockButton, mousePos);
-            updateButtonHover(paperButton, mousePos);
-            updateButtonHover(scissorsButton, mousePos);
+            for (auto& button : choiceButtons) {
+                updateButtonHover(button, mousePos);
+            }
         }
         else if (currentState == GameState::GameOver) {
             updateButtonHover(continueButton, mousePos);
@@ -355,8 +593,8 @@ private:
         playerScore = 0;
         computerScore = 0;
         currentRound = 1;
-        playerChoice = Choice::None;
-        computerChoice = Choice::None;
+        playerChoice = NO_CHOICE;
+        computerChoice = NO_CHOICE;
         currentState = GameState::SelectRounds;
         updateScoreText();
     }
@@ -369,6 +607,10 @@ private:
         window.draw(roundText);
 
         switch (currentState) {
+            case GameState::EnterName:
+                renderNameEntry();
+                break;
+
             case GameState::SelectRounds:
                 renderRoundSelection();
                 break;
@@ -386,89 +628,49 @@ private:
         window.display();
     }
 
+    void renderNameEntry() {
+        window.draw(promptText);
+        window.draw(nameText);
+    }
+
     void renderRoundSelection() {
-        sf::Text title("Select Number of Rounds", font, 40);
-        title.setPosition(
-            (window.getSize().x - title.getGlobalBounds().width) / 2,
-            100
-        );
-        window.draw(title);
+        window.draw(titleText);
+        window.draw(memoryText);
 
         for (const auto& button : roundButtons) {
             window.draw(button.shape);
             window.draw(button.text);
         }
+
+        window.draw(difficultyTitle);
+        for (const auto& button : difficultyButtons) {
+            window.draw(button.shape);
+            window.draw(button.text);
+        }
     }
 
     void renderGame() {
         // Draw choice buttons
-        window.draw(rockButton.shape);
-        window.draw(rockButton.text);
-        window.draw(paperButton.shape);
-        window.draw(paperButton.text);
-        window.draw(scissorsButton.shape);
-        window.draw(scissorsButton.text);
+        for (const auto& button : choiceButtons) {
+            window.draw(button.shape);
+            window.draw(button.text);
+        }
 
         // Draw choices and result if round is complete
         if (currentState == GameState::RoundEnd) {
             window.draw(resultText);
-            
-            // Display choices
-            sf::Text playerChoiceText("Your choice: " + choiceToString(playerChoice), font, 24);
-            sf::Text computerChoiceText("Computer's choice: " + choiceToString(computerChoice), font, 24);
-            
-            playerChoiceText.setPosition(200, 400);
-            computerChoiceText.setPosition(200, 450);
-            
             window.draw(playerChoiceText);
             window.draw(computerChoiceText);
 
             // Add instruction for draw
             if (playerChoice == computerChoice) {
-                sf::Text drawText("Round will not count. Click to play again.", font, 24);
-                drawText.setFillColor(sf::Color::Yellow);
-                drawText.setPosition(
-                    (window.getSize().x - drawText.getGlobalBounds().width) / 2,
-                    500
-                );
                 window.draw(drawText);
             }
         }
     }
 
     void renderGameOver() {
-        sf::Text gameOverText;
-        gameOverText.setFont(font);
-        gameOverText.setCharacterSize(40);
-        
-        if (playerScore > computerScore) {
-            gameOverText.setString("Congratulations! You Won!");
-            gameOverText.setFillColor(sf::Color::Green);
-        }
-        else {
-            gameOverText.setString("Game Over! Computer Wins!");
-            gameOverText.setFillColor(sf::Color::Red);
-        }
-        
-        gameOverText.setPosition(
-            (window.getSize().x - gameOverText.getGlobalBounds().width) / 2,
-            200
-        );
-        
         window.draw(gameOverText);
-
-        // Draw final score
-        sf::Text finalScoreText;
-        finalScoreText.setFont(font);
-        finalScoreText.setCharacterSize(30);
-        finalScoreText.setString("Final Score: Player " + std::to_string(playerScore) + 
-                                " - Computer " + std::to_string(computerScore));
-        finalScoreText.setFillColor(sf::Color::White);
-        finalScoreText.setPosition(
-            (window.getSize().x - finalScoreText.getGlobalBounds().width) / 2,
-            300
-        );
-        
         window.draw(finalScoreText);
         
         // Draw continue button
@@ -477,16 +679,50 @@ private:
     }
 
     std::string choiceToString(Choice choice) {
-        switch (choice) {
-            case Choice::Rock: return "Rock";
-            case Choice::Paper: return "Paper";
-            case Choice::Scissors: return "Scissors";
-            default: return "None";
+        return choice == NO_CHOICE ? "None" : Variant::NAMES[choice];
+    }
+
+    // Fades and slides the round result in while resultDisplayTimer runs down, and the
+    // game-over texts once it restarts for the final screen. Only colors and positions change.
+    void updateTransitions() {
+        float t = 1.0f - std::max(resultDisplayTimer, 0.0f) / RESULT_DISPLAY_TIME;
+        float fade = Easing::easeOutQuad(std::min(t * 2.0f, 1.0f));  // Fully visible halfway
+        float offset = SLIDE_DISTANCE * (1.0f - Easing::easeOutCubic(t));
+
+        if (currentState == GameState::RoundEnd) {
+            resultText.setFillColor(withAlpha(resultColor, fade));
+            resultText.setPosition(resultText.getPosition().x, RESULT_Y - offset);
+            playerChoiceText.setFillColor(withAlpha(sf::Color::White, fade));
+            playerChoiceText.setPosition(CHOICE_TEXT_X - offset, 400);
+            computerChoiceText.setFillColor(withAlpha(sf::Color::White, fade));
+            computerChoiceText.setPosition(CHOICE_TEXT_X + offset, 450);
+            drawText.setFillColor(withAlpha(sf::Color::Yellow, fade));
+        }
+        else if (currentState == GameState::GameOver) {
+            gameOverText.setFillColor(withAlpha(gameOverColor, fade));
+            gameOverText.setPosition(gameOverText.getPosition().x, GAME_OVER_Y - offset);
+            finalScoreText.setFillColor(withAlpha(sf::Color::White, fade));
         }
     }
 
+    static sf::Color withAlpha(sf::Color color, float alpha) {
+        color.a = static_cast<sf::Uint8>(255 * alpha);
+        return color;
+    }
+
+    // Whether the next frame can differ from this one without any input: a result is fading
+    // in or the pause between rounds is running
+    bool isAnimating() const {
+        return resultDisplayTimer > 0 || currentState == GameState::RoundEnd;
+    }
+
     void updateGame() {
-        float deltaTime = gameClock.restart().asSeconds();
+        float deltaTime = std::min(gameClock.restart().asSeconds(), MAX_FRAME_TIME);
+
+        if (resultDisplayTimer > 0) {
+            resultDisplayTimer -= deltaTime;
+            updateTransitions();
+        }
 
         switch (currentState) {
             case GameState::RoundEnd:
@@ -495,23 +731,40 @@ private:
                 if (roundEndTimer <= 0) {
                     if (playerScore >= targetScore || computerScore >= targetScore) {
                         currentState = GameState::GameOver;
+                        resultDisplayTimer = RESULT_DISPLAY_TIME;
+                        updateTransitions();
                     } else {
                         currentState = GameState::Playing;
-                        playerChoice = Choice::None;
-                        computerChoice = Choice::None;
+                        playerChoice = NO_CHOICE;
+                        computerChoice = NO_CHOICE;
                         currentRound++;
                         updateScoreText();
                     }
                 }
                 break;
 
-            case GameState::Playing:
-                // Update any animations or effects
-                if (resultDisplayTimer > 0) {
-                    resultDisplayTimer -= deltaTime;
-                    // Could update text opacity or position here
-                }
+            default:
                 break;
         }
     }
-}; 
\ No newline at end of file
+};
+
+using RockPaperScissors = BasicRockPaperScissors<>;
+
+class RockPaperScissorsLauncher : public VariantLauncher {
+private:
+    template <int WEAPONS>
+    static bool runVariant(sf::RenderWindow& window, sf::Font& font) {
+        BasicRockPaperScissors<WEAPONS> game(window, font);
+        return game.run();
+    }
+
+public:
+    RockPaperScissorsLauncher(sf::RenderWindow& gameWindow, sf::Font& gameFont)
+        : VariantLauncher(gameWindow, gameFont, "Select Variant", 300, {
+              {"Rock Paper Scissors", &runVariant<3>},
+              {"+ Lizard Spock (5)", &runVariant<5>},
+              {RPSVariant<7>::TITLE, &runVariant<7>},
+              {RPSVariant<15>::TITLE, &runVariant<15>}
+          }) {}
+};
@@ -0,0 +1,316 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "RockPaperScissorsCore.hpp"
+
+// Online pattern predictor for Rock Paper Scissors.
+// Keeps decayed frequency tables of the opponent's next move for several context lengths at
+// once: the opponent's last 1..MAX_ORDER moves, and the last 1..MAX_ORDER full rounds (both
+// players' moves). Contexts are rolling indices, so a round costs O(CHOICES) per table, and
+// every table is allocated up front with at most MAX_ROWS rows, so memory never grows.
+// Moves are indices 0..CHOICES-1. With more weapons each context is seen less often, so the
+// default context length shrinks as CHOICES grows.
+template <int CHOICES = 3, int MAX_ORDER = (CHOICES <= 3 ? 4 : CHOICES <= 7 ? 3 : 2)>
+class BasicRPSPredictor {
+public:
+    using Distribution = std::array<float, CHOICES>;
+    using Rules = BasicRPSRules<CHOICES>;
+
+private:
+    static constexpr size_t MAX_ROWS = 1 << 13;
+    static constexpr float DECAY = 0.9f;         // Per observation of the same context
+    static constexpr float PRIOR_WEIGHT = 0.5f;  // Uniform guess mixed into every prediction
+
+    struct Table {
+        int order;
+        bool joint;           // Context holds both players' moves, not only the opponent's
+        uint64_t modulus;     // Number of distinct contexts
+        uint64_t context;
+        size_t rows;
+        std::vector<float> counts;  // rows * CHOICES
+        std::vector<float> totals;  // rows
+    };
+
+    std::vector<Table> tables;
+    uint64_t rounds;
+
+public:
+    BasicRPSPredictor() : rounds(0) {
+        for (int joint = 0; joint < 2; joint++) {
+            for (int order = 1; order <= MAX_ORDER; order++) {
+                Table table;
+                table.order = order;
+                table.joint = joint != 0;
+                table.modulus = 1;
+                for (int i = 0; i < order * (joint ? 2 : 1); i++) {
+                    table.modulus *= CHOICES;
+                }
+                table.context = 0;
+                table.rows = size_t(table.modulus < MAX_ROWS ? table.modulus : MAX_ROWS);
+                table.counts.assign(table.rows * CHOICES, 0.0f);
+                table.totals.assign(table.rows, 0.0f);
+                tables.push_back(table);
+            }
+        }
+    }
+
+    void reset() {
+        for (auto& table : tables) {
+            table.context = 0;
+            std::fill(table.counts.begin(), table.counts.end(), 0.0f);
+            std::fill(table.totals.begin(), table.totals.end(), 0.0f);
+        }
+        rounds = 0;
+    }
+
+    uint64_t getRounds() const { return rounds; }
+
+    // Records a finished round: what the opponent played and what we played
+    void update(int opponentMove, int ownMove) {
+        for (auto& table : tables) {
+            if (rounds >= uint64_t(table.order)) {
+                size_t row = rowOf(table);
+                float* counts = &table.counts[row * CHOICES];
+                for (int i = 0; i < CHOICES; i++) {
+                    counts[i] *= DECAY;
+                }
+                counts[opponentMove] += 1.0f;
+                table.totals[row] = table.totals[row] * DECAY + 1.0f;
+            }
+
+            uint64_t symbol = table.joint ? uint64_t(opponentMove * CHOICES + ownMove) : uint64_t(opponentMove);
+            uint64_t base = table.joint ? CHOICES * CHOICES : CHOICES;
+            table.context = (table.context * base + symbol) % table.modulus;
+        }
+        rounds++;
+    }
+
+    // Probability of each opponent move next round. Longer contexts that have been seen
+    // more often weigh more; an unseen context contributes nothing.
+    Distribution predict() const {
+        Distribution p;
+        p.fill(PRIOR_WEIGHT / CHOICES);
+        float weight = PRIOR_WEIGHT;
+        for (const auto& table : tables) {
+            if (rounds < uint64_t(table.order)) {
+                continue;
+            }
+            size_t row = rowOf(table);
+            float total = table.totals[row];
+            if (total <= 0.0f) {
+                continue;
+            }
+            float w = float(table.order) * total / (total + 1.0f);
+            const float* counts = &table.counts[row * CHOICES];
+            for (int i = 0; i < CHOICES; i++) {
+                p[i] += w * counts[i] / total;
+            }
+            weight += w;
+        }
+        for (auto& x : p) {
+            x /= weight;
+        }
+        return p;
+    }
+
+    // Move with the best expected outcome against a distribution; ties are broken at random
+    template <typename Random>
+    static int bestResponse(const Distribution& p, Random& gen) {
+        float bestValue = -2.0f;
+        int best[CHOICES];
+        int count = 0;
+        for (int move = 0; move < CHOICES; move++) {
+            float value = 0.0f;
+            for (int other = 0; other < CHOICES; other++) {
+                value += Rules::payoff(move, other) * p[other];
+            }
+            if (value > bestValue + 1e-6f) {
+                bestValue = value;
+                count = 0;
+            }
+            if (value > bestValue - 1e-6f) {
+                best[count++] = move;
+            }
+        }
+        return best[gen() % count];
+    }
+
+private:
+    static size_t rowOf(const Table& table) {
+        return size_t(table.context % table.rows);
+    }
+};
+
+using RPSPredictor = BasicRPSPredictor<3, 4>;
+
+// Ensemble of simple strategies, each scored online, with meta-strategies choosing among them.
+// Every strategy predicts the opponent's next move; each prediction yields CHOICES candidate
+// replies (the counter, and the counter shifted by 1..CHOICES-1, which covers an opponent who
+// anticipates the counter). Each meta-strategy scores every candidate with its own decay and
+// follows the best one; the ensemble follows the meta-strategy with the best recent record.
+// With exploit resistance on, it plays uniformly at random whenever no meta-strategy is
+// currently winning, so an opponent who out-thinks it gains nothing over chance.
+// All work per round is a fixed number of array updates.
+template <int CHOICES = 3>
+class BasicRPSEnsemble {
+public:
+    using Predictor = BasicRPSPredictor<CHOICES>;
+    using Rules = BasicRPSRules<CHOICES>;
+
+    enum Strategy { Frequency, NGram, SelfModel, Mirror, Rotation, BiasedRandom, STRATEGY_COUNT };
+
+private:
+    static constexpr int CANDIDATES = STRATEGY_COUNT * CHOICES;
+    static constexpr int META_COUNT = 4;
+    static constexpr float META_DECAYS[META_COUNT] = {0.5f, 0.8f, 0.95f, 0.99f};
+    static constexpr float SELECTION_DECAY = 0.9f;
+    static constexpr float FREQUENCY_DECAY = 0.98f;
+    static constexpr float CONFIDENCE_THRESHOLD = 0.5f;
+
+    Predictor ngram;
+    Predictor selfModel;  // Our own moves as an opponent's pattern model would see them
+    std::array<float, CHOICES> frequency;
+    int lastOpponent;
+    int lastOwn;
+
+    bool proposed;
+    std::array<int, CANDIDATES> candidateMoves;
+    std::array<std::array<float, CANDIDATES>, META_COUNT> candidateScores;
+    std::array<int, META_COUNT> metaMoves;
+    std::array<float, META_COUNT> metaScores;
+
+    bool exploitResistant;
+    std::mt19937 gen;
+
+public:
+    explicit BasicRPSEnsemble(bool resistant = true, unsigned seed = std::random_device{}())
+        : exploitResistant(resistant), gen(seed) {
+        reset();
+    }
+
+    void reset() {
+        ngram.reset();
+        selfModel.reset();
+        frequency.fill(0.0f);
+        lastOpponent = -1;
+        lastOwn = -1;
+        proposed = false;
+        for (auto& scores : candidateScores) {
+            scores.fill(0.0f);
+        }
+        metaScores.fill(0.0f);
+    }
+
+    void setExploitResistant(bool resistant) { exploitResistant = resistant; }
+
+    // Move to play this round; call update() with the outcome afterwards
+    int chooseMove() {
+        propose();
+
+        int bestMeta = 0;
+        for (int m = 1; m < META_COUNT; m++) {
+            if (metaScores[m] > metaScores[bestMeta]) {
+                bestMeta = m;
+            }
+        }
+        if (exploitResistant && metaScores[bestMeta] < CONFIDENCE_THRESHOLD) {
+            return int(gen() % CHOICES);
+        }
+        return metaMoves[bestMeta];
+    }
+
+    void update(int opponentMove, int ownMove) {
+        propose();
+
+        // Score every candidate and meta-strategy on what they proposed this round
+        for (int m = 0; m < META_COUNT; m++) {
+            for (int c = 0; c < CANDIDATES; c++) {
+                candidateScores[m][c] = candidateScores[m][c] * META_DECAYS[m] +
+                                        Rules::payoff(candidateMoves[c], opponentMove);
+            }
+            metaScores[m] = metaScores[m] * SELECTION_DECAY + Rules::payoff(metaMoves[m], opponentMove);
+        }
+
+        // Then let the strategies learn
+        ngram.update(opponentMove, ownMove);
+        selfModel.update(ownMove, opponentMove);
+        for (auto& f : frequency) {
+            f *= FREQUENCY_DECAY;
+        }
+        frequency[opponentMove] += 1.0f;
+        lastOpponent = opponentMove;
+        lastOwn = ownMove;
+        proposed = false;
+    }
+
+private:
+    // Fills this round's candidate replies and each meta-strategy's pick, once per round
+    void propose() {
+        if (proposed) {
+            return;
+        }
+        proposed = true;
+
+        int predictions[STRATEGY_COUNT];
+        predictions[Frequency] = argmax(frequency);
+        predictions[NGram] = argmax(ngram.predict());
+        predictions[SelfModel] = argmax(selfModel.predict());  // The shifts cover being countered
+        predictions[Mirror] = lastOwn >= 0 ? lastOwn : int(gen() % CHOICES);
+        predictions[Rotation] = lastOpponent >= 0 ? lastOpponent : int(gen() % CHOICES);
+        predictions[BiasedRandom] = sample(frequency);
+
+        for (int s = 0; s < STRATEGY_COUNT; s++) {
+            int counter = (predictions[s] + 1) % CHOICES;  // One step up always beats it
+            for (int shift = 0; shift < CHOICES; shift++) {
+                candidateMoves[s * CHOICES + shift] = (counter + shift) % CHOICES;
+            }
+        }
+
+        for (int m = 0; m < META_COUNT; m++) {
+            int best = 0;
+            for (int c = 1; c < CANDIDATES; c++) {
+                if (candidateScores[m][c] > candidateScores[m][best]) {
+                    best = c;
+                }
+            }
+            metaMoves[m] = candidateMoves[best];
+        }
+    }
+
+    int argmax(const std::array<float, CHOICES>& values) {
+        int best[CHOICES];
+        int count = 0;
+        for (int i = 0; i < CHOICES; i++) {
+            if (count == 0 || values[i] > values[best[0]]) {
+                count = 0;
+            }
+            if (count == 0 || values[i] == values[best[0]]) {
+                best[count++] = i;
+            }
+        }
+        return best[gen() % count];
+    }
+
+    int sample(const std::array<float, CHOICES>& weights) {
+        float total = 0.0f;
+        for (float w : weights) {
+            total += w;
+        }
+        if (total <= 0.0f) {
+            return int(gen() % CHOICES);
+        }
+        float r = std::uniform_real_distribution<float>(0.0f, total)(gen);
+        for (int i = 0; i < CHOICES; i++) {
+            r -= weights[i];
+            if (r < 0.0f) {
+                return i;
+            }
+        }
+        return CHOICES - 1;
+    }
+};
+
+using RPSEnsemble = BasicRPSEnsemble<3>;
@@ -0,0 +1,89 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+// Window-free Rock Paper Scissors rules, shared by the game, its computer players and the
+// offline tournament runner. Moves are indices 0..CHOICES-1 into RPSVariant<CHOICES>::NAMES.
+enum class RPSOutcome { Draw, FirstWins, SecondWins };
+
+// Odd-sized variants where every weapon beats the (CHOICES-1)/2 weapons listed just before it
+// (cyclically) and loses to the ones just after it. Both outcome tables are built at compile
+// time, so judging a round is one lookup at any size.
+template <int CHOICES = 3>
+struct BasicRPSRules {
+    static_assert(CHOICES >= 3 && CHOICES % 2 == 1, "Every move must beat as many moves as it loses to");
+
+private:
+    static constexpr std::array<RPSOutcome, CHOICES * CHOICES> makeOutcomes() {
+        std::array<RPSOutcome, CHOICES * CHOICES> table{};
+        for (int first = 0; first < CHOICES; first++) {
+            for (int second = 0; second < CHOICES; second++) {
+                int distance = (first - second + CHOICES) % CHOICES;
+                table[first * CHOICES + second] = distance == 0 ? RPSOutcome::Draw
+                                                : distance <= CHOICES / 2 ? RPSOutcome::FirstWins
+                                                : RPSOutcome::SecondWins;
+            }
+        }
+        return table;
+    }
+
+    static constexpr std::array<int8_t, CHOICES * CHOICES> makePayoffs() {
+        std::array<int8_t, CHOICES * CHOICES> table{};
+        for (int i = 0; i < CHOICES * CHOICES; i++) {
+            RPSOutcome outcome = makeOutcomes()[i];
+            table[i] = outcome == RPSOutcome::FirstWins ? 1 : outcome == RPSOutcome::SecondWins ? -1 : 0;
+        }
+        return table;
+    }
+
+public:
+    static constexpr std::array<RPSOutcome, CHOICES * CHOICES> OUTCOMES = makeOutcomes();
+    static constexpr std::array<int8_t, CHOICES * CHOICES> PAYOFFS = makePayoffs();
+
+    static RPSOutcome judge(int first, int second) {
+        return OUTCOMES[first * CHOICES + second];
+    }
+
+    // +1 if `move` wins against `opponentMove`, -1 if it loses, 0 for a draw
+    static int payoff(int move, int opponentMove) {
+        return PAYOFFS[move * CHOICES + opponentMove];
+    }
+
+    static bool beats(int a, int b) {
+        return PAYOFFS[a * CHOICES + b] > 0;
+    }
+};
+
+using RPSRules = BasicRPSRules<3>;
+
+// Weapon names in rule order. The classic three keep Rock, Paper, Scissors = 0, 1, 2; the
+// larger variants list the usual rules backwards, rotated to start at Rock.
+template <int CHOICES>
+struct RPSVariant;
+
+template <>
+struct RPSVariant<3> {
+    static constexpr const char* TITLE = "Rock Paper Scissors";
+    static constexpr const char* NAMES[3] = {"Rock", "Paper", "Scissors"};
+};
+
+template <>
+struct RPSVariant<5> {
+    static constexpr const char* TITLE = "Rock Paper Scissors Lizard Spock";
+    static constexpr const char* NAMES[5] = {"Rock", "Spock", "Paper", "Lizard", "Scissors"};
+};
+
+template <>
+struct RPSVariant<7> {
+    static constexpr const char* TITLE = "RPS-7";
+    static constexpr const char* NAMES[7] = {"Rock", "Water", "Air", "Paper", "Sponge", "Scissors", "Fire"};
+};
+
+template <>
+struct RPSVariant<15> {
+    static constexpr const char* TITLE = "RPS-15";
+    static constexpr const char* NAMES[15] = {
+        "Rock", "Gun", "Lightning", "Devil", "Dragon", "Water", "Air", "Paper",
+        "Sponge", "Wolf", "Tree", "Human", "Snake", "Scissors", "Fire"
+    };
+};
@@ -0,0 +1,160 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Per-player memory of the Rock Paper Scissors computer, kept between sessions.
+// Instead of the learned tables themselves (hundreds of KB of mostly empty rows), each player
+// keeps a fixed-size record with their last HISTORY rounds; replaying them rebuilds the n-gram
+// counts and ensemble scores in about a millisecond, and every decayed statistic has
+// forgotten anything older anyway.
+//
+// File layout (native endianness): Header, then one Record per player in order of first play.
+// A record is found by scanning names, and a round is saved by rewriting its history byte and
+// the round counter in place, so the file is never rewritten as a whole.
+class RPSModelStore {
+public:
+    static const uint32_t HISTORY = 1024;
+    static const size_t NAME_LENGTH = 16;
+
+    using Round = std::pair<int, int>;  // Player's move, computer's move
+
+private:
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t history;
+        uint32_t choices;
+    };
+
+    struct Record {
+        char name[NAME_LENGTH];  // NUL-padded, not necessarily NUL-terminated
+        uint32_t rounds;         // Total rounds ever played; the ring slot is rounds % HISTORY
+        uint32_t reserved;
+        uint8_t history[HISTORY];  // playerMove * choices + computerMove
+    };
+
+    static const uint32_t VERSION = 1;
+
+    const std::string filename;
+    const uint32_t choices;
+    std::fstream file;
+    bool loaded;
+    bool isNew;          // Current player has no record yet
+    uint64_t offset;     // Of the current player's record
+    Record record;
+
+public:
+    explicit RPSModelStore(const std::string& file = "rps_models.bin", int choiceCount = 3)
+        : filename(file), choices(uint32_t(choiceCount)), loaded(false), isNew(false), offset(0) {
+        std::memset(&record, 0, sizeof(record));
+    }
+
+    // Looks the player up and returns their recent rounds, oldest first
+    std::vector<Round> load(const std::string& name) {
+        loaded = false;
+        std::vector<Round> rounds;
+        if (!openFile()) {
+            return rounds;
+        }
+
+        std::memset(&record, 0, sizeof(record));
+        std::strncpy(record.name, name.c_str(), NAME_LENGTH);
+        isNew = true;
+        offset = sizeof(Header);
+
+        file.clear();
+        file.seekg(0, std::ios::end);
+        uint64_t end = uint64_t(file.tellg());
+        char storedName[NAME_LENGTH];
+        for (; offset + sizeof(Record) <= end; offset += sizeof(Record)) {
+            file.seekg(std::streamoff(offset));
+            if (!file.read(storedName, NAME_LENGTH)) {
+                break;
+            }
+            if (std::memcmp(storedName, record.name, NAME_LENGTH) == 0) {
+                file.seekg(std::streamoff(offset));
+                file.read(reinterpret_cast<char*>(&record), sizeof(record));
+                isNew = !file;
+                break;
+            }
+        }
+        file.clear();
+
+        if (!isNew) {
+            uint32_t count = record.rounds < HISTORY ? record.rounds : HISTORY;
+            for (uint32_t i = record.rounds - count; i != record.rounds; i++) {
+                uint8_t value = record.history[i % HISTORY];
+                rounds.emplace_back(value / choices, value % choices);
+            }
+        }
+        loaded = true;
+        return rounds;
+    }
+
+    uint32_t getRounds() const { return loaded ? record.rounds : 0; }
+
+    // Saves one round of the current player
+    void append(int playerMove, int computerMove) {
+        if (!loaded) {
+            return;
+        }
+        uint32_t slot = record.rounds % HISTORY;
+        record.history[slot] = uint8_t(playerMove * choices + computerMove);
+        record.rounds++;
+
+        file.clear();
+        if (isNew) {
+            // The new record goes at the end (offset) in one write
+            file.seekp(std::streamoff(offset));
+            file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+            isNew = !file;
+        } else {
+            file.seekp(std::streamoff(offset + offsetof(Record, rounds)));
+            file.write(reinterpret_cast<const char*>(&record.rounds), sizeof(record.rounds));
+            file.seekp(std::streamoff(offset + offsetof(Record, history) + slot));
+            file.write(reinterpret_cast<const char*>(&record.history[slot]), 1);
+        }
+        file.flush();
+    }
+
+private:
+    bool openFile() {
+        if (file.is_open()) {
+            return true;
+        }
+
+        file.open(filename, std::ios::in | std::ios::out | std::ios::binary);
+        if (!file.is_open()) {
+            // Create it with just a header
+            std::ofstream create(filename, std::ios::binary);
+            Header header = makeHeader();
+            create.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            create.close();
+            file.open(filename, std::ios::in | std::ios::out | std::ios::binary);
+            return file.is_open();
+        }
+
+        Header header;
+        Header expected = makeHeader();
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(&header, &expected, sizeof(header)) != 0) {
+            file.close();  // Someone else's file, or another format; leave it alone
+            return false;
+        }
+        return true;
+    }
+
+    Header makeHeader() const {
+        Header header;
+        std::memcpy(header.magic, "RPSM", 4);
+        header.version = VERSION;
+        header.history = HISTORY;
+        header.choices = choices;
+        return header;
+    }
+};
@@ -0,0 +1,257 @@
+// Rock Paper Scissors bot tournament.
+// Plays every bot against every other bot with the rules and computer players the game uses
+// (RockPaperScissorsCore.hpp, RockPaperScissorsAI.hpp) and prints a win-rate matrix and
+// rounds/sec. Each pairing is split into matches of fresh bots; matches are handed out to
+// worker threads, which keep their own tallies until the end, so nothing is shared per round.
+//
+// Build: g++ -O2 -std=c++17 -pthread RockPaperScissorsTournament.cpp -o rps_tournament
+// Usage: rps_tournament [--rounds N] [--match-rounds N] [--threads N] [bot names...]
+//
+// --rounds is per pairing (default 1000000), --match-rounds the length of one match before
+// both bots are recreated (default 10000). Without bot names every known bot plays.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "RockPaperScissorsAI.hpp"
+
+class Bot {
+public:
+    virtual ~Bot() {}
+    virtual int chooseMove() = 0;
+    virtual void observe(int ownMove, int opponentMove) = 0;
+};
+
+class RandomBot : public Bot {
+private:
+    std::mt19937 gen;
+
+public:
+    explicit RandomBot(unsigned seed) : gen(seed) {}
+    int chooseMove() override { return int(gen() % 3); }
+    void observe(int, int) override {}
+};
+
+// Plays `favourite` half of the time, otherwise at random
+class BiasedBot : public Bot {
+private:
+    std::mt19937 gen;
+    int favourite;
+
+public:
+    BiasedBot(unsigned seed, int move) : gen(seed), favourite(move) {}
+    int chooseMove() override { return gen() % 2 ? favourite : int(gen() % 3); }
+    void observe(int, int) override {}
+};
+
+class CycleBot : public Bot {
+private:
+    int next;
+
+public:
+    CycleBot() : next(0) {}
+    int chooseMove() override { return next; }
+    void observe(int ownMove, int) override { next = (ownMove + 1) % 3; }
+};
+
+// Plays whatever beats the opponent's previous move
+class BeatLastBot : public Bot {
+private:
+    int next;
+
+public:
+    BeatLastBot() : next(0) {}
+    int chooseMove() override { return next; }
+    void observe(int, int opponentMove) override { next = (opponentMove + 1) % 3; }
+};
+
+template <int MAX_ORDER>
+class PredictorBot : public Bot {
+private:
+    BasicRPSPredictor<3, MAX_ORDER> predictor;
+    std::mt19937 gen;
+
+public:
+    explicit PredictorBot(unsigned seed) : gen(seed) {}
+    int chooseMove() override { return predictor.bestResponse(predictor.predict(), gen); }
+    void observe(int ownMove, int opponentMove) override { predictor.update(opponentMove, ownMove); }
+};
+
+class EnsembleBot : public Bot {
+private:
+    RPSEnsemble ensemble;
+
+public:
+    EnsembleBot(unsigned seed, bool resistant) : ensemble(resistant, seed) {}
+    int chooseMove() override { return ensemble.chooseMove(); }
+    void observe(int ownMove, int opponentMove) override { ensemble.update(opponentMove, ownMove); }
+};
+
+struct BotType {
+    std::string name;
+    std::function<std::unique_ptr<Bot>(unsigned seed)> create;
+};
+
+static std::vector<BotType> knownBots() {
+    return {
+        {"random", [](unsigned seed) { return std::unique_ptr<Bot>(new RandomBot(seed)); }},
+        {"biased", [](unsigned seed) { return std::unique_ptr<Bot>(new BiasedBot(seed, 0)); }},
+        {"cycle", [](unsigned) { return std::unique_ptr<Bot>(new CycleBot()); }},
+        {"beatlast", [](unsigned) { return std::unique_ptr<Bot>(new BeatLastBot()); }},
+        {"ngram2", [](unsigned seed) { return std::unique_ptr<Bot>(new PredictorBot<2>(seed)); }},
+        {"ngram4", [](unsigned seed) { return std::unique_ptr<Bot>(new PredictorBot<4>(seed)); }},
+        {"ngram6", [](unsigned seed) { return std::unique_ptr<Bot>(new PredictorBot<6>(seed)); }},
+        {"ensemble", [](unsigned seed) { return std::unique_ptr<Bot>(new EnsembleBot(seed, true)); }},
+        {"ensemble-greedy", [](unsigned seed) { return std::unique_ptr<Bot>(new EnsembleBot(seed, false)); }},
+    };
+}
+
+struct Tally {
+    unsigned long long wins = 0;    // By the first bot of the pairing
+    unsigned long long losses = 0;
+    unsigned long long draws = 0;
+};
+
+struct Match {
+    int first;
+    int second;
+    unsigned long long rounds;
+    unsigned seed;
+};
+
+static Tally playMatch(const BotType& firstType, const BotType& secondType, const Match& match) {
+    std::unique_ptr<Bot> first = firstType.create(match.seed);
+    std::unique_ptr<Bot> second = secondType.create(match.seed * 2654435761u + 1);
+    Tally tally;
+    for (unsigned long long r = 0; r < match.rounds; r++) {
+        int a = first->chooseMove();
+        int b = second->chooseMove();
+        switch (RPSRules::judge(a, b)) {
+            case RPSOutcome::FirstWins: tally.wins++; break;
+            case RPSOutcome::SecondWins: tally.losses++; break;
+            case RPSOutcome::Draw: tally.draws++; break;
+        }
+        first->observe(a, b);
+        second->observe(b, a);
+    }
+    return tally;
+}
+
+int main(int argc, char* argv[]) {
+    unsigned long long roundsPerPair = 1000000;
+    unsigned long long matchRounds = 10000;
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> names;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--rounds" && i + 1 < argc) {
+            roundsPerPair = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--match-rounds" && i + 1 < argc) {
+            matchRounds = std::max(1ull, std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threadCount = std::max(1, std::atoi(argv[++i]));
+        } else {
+            names.push_back(arg);
+        }
+    }
+
+    std::vector<BotType> bots;
+    for (const auto& type : knownBots()) {
+        if (names.empty() || std::find(names.begin(), names.end(), type.name) != names.end()) {
+            bots.push_back(type);
+        }
+    }
+    if (bots.size() < 2) {
+        std::cerr << "Need at least two bots; known bots:";
+        for (const auto& type : knownBots()) {
+            std::cerr << " " << type.name;
+        }
+        std::cerr << std::endl;
+        return 1;
+    }
+
+    // Every pairing, split into matches
+    std::vector<Match> matches;
+    for (int i = 0; i < int(bots.size()); i++) {
+        for (int j = i + 1; j < int(bots.size()); j++) {
+            for (unsigned long long done = 0; done < roundsPerPair; done += matchRounds) {
+                unsigned seed = unsigned(matches.size() * 7919 + 1);
+                matches.push_back({i, j, std::min(matchRounds, roundsPerPair - done), seed});
+            }
+        }
+    }
+
+    size_t n = bots.size();
+    std::vector<std::vector<Tally>> perThread(threadCount, std::vector<Tally>(n * n));
+    std::atomic<size_t> nextMatch(0);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threadCount; t++) {
+        workers.emplace_back([&, t] {
+            std::vector<Tally>& tallies = perThread[t];
+            size_t index;
+            while ((index = nextMatch.fetch_add(1)) < matches.size()) {
+                const Match& match = matches[index];
+                Tally result = playMatch(bots[match.first], bots[match.second], match);
+                Tally& tally = tallies[match.first * n + match.second];
+                tally.wins += result.wins;
+                tally.losses += result.losses;
+                tally.draws += result.draws;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<Tally> totals(n * n);
+    for (const auto& tallies : perThread) {
+        for (size_t k = 0; k < n * n; k++) {
+            totals[k].wins += tallies[k].wins;
+            totals[k].losses += tallies[k].losses;
+            totals[k].draws += tallies[k].draws;
+        }
+    }
+
+    // Row bot's share of decided rounds against the column bot, in percent
+    const int width = 16;
+    std::cout << std::setw(width) << "";
+    for (const auto& type : bots) {
+        std::cout << std::setw(width) << type.name;
+    }
+    std::cout << std::setw(width) << "mean" << "\n" << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < n; i++) {
+        std::cout << std::setw(width) << bots[i].name;
+        double sum = 0.0;
+        for (size_t j = 0; j < n; j++) {
+            if (i == j) {
+                std::cout << std::setw(width) << "-";
+                continue;
+            }
+            const Tally& tally = i < j ? totals[i * n + j] : totals[j * n + i];
+            unsigned long long won = i < j ? tally.wins : tally.losses;
+            unsigned long long decided = tally.wins + tally.losses;
+            double rate = decided ? 100.0 * won / decided : 50.0;
+            sum += rate;
+            std::cout << std::setw(width) << rate;
+        }
+        std::cout << std::setw(width) << sum / (n - 1) << "\n";
+    }
+
+    unsigned long long totalRounds = roundsPerPair * (n * (n - 1) / 2);
+    std::cout << "\n" << totalRounds << " rounds in " << std::setprecision(2) << seconds << " s on "
+              << threadCount << " threads: " << std::setprecision(0) << totalRounds / seconds
+              << " rounds/s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,185 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "GameRegistry.hpp"
+
+// Every difficulty or opponent a score can be set against
+enum class ScoreDifficulty : uint8_t { None, Easy, Medium, Hard, Negamax, MonteCarlo };
+
+// A plain 24-byte record with no heap strings, so copying, storing and encoding entries never
+// allocates. The name sits NUL-padded in a fixed buffer, which is only NUL-terminated when
+// shorter than the buffer; longer names are cut to fit. The game is a GameRegistry id; its
+// title is only spelled out by the text, journal and board encodings.
+class ScoreEntry {
+public:
+    static const size_t NAME_LENGTH = 16;  // The name prompts accept 15 characters
+    static const size_t GAME_LENGTH = 32;  // Longer titles are cut to fit
+    static const size_t ROW_LENGTH = 64;   // Enough for any format()ted row
+    static const int DIFFICULTY_COUNT = 6;
+
+private:
+    static const uint8_t OBSTACLES = 1;
+
+    int32_t score;
+    ScoreDifficulty difficulty;
+    uint8_t flags;
+    uint8_t game;
+    char playerName[NAME_LENGTH];
+
+public:
+    // Default constructor
+    ScoreEntry() : score(0), difficulty(ScoreDifficulty::None), flags(0), game(0) {
+        setText(playerName, NAME_LENGTH, "");
+    }
+
+    // Parameter constructor
+    ScoreEntry(std::string_view name, int s, std::string_view diff, bool obs)
+        : ScoreEntry("Snake", name, s, difficultyFromName(diff), obs) {}
+
+    ScoreEntry(std::string_view gameName, std::string_view name, int s, std::string_view diff, bool obs)
+        : ScoreEntry(gameName, name, s, difficultyFromName(diff), obs) {}
+
+    ScoreEntry(std::string_view gameName, std::string_view name, int s, ScoreDifficulty diff, bool obs)
+        : score(s), difficulty(diff), flags(obs ? OBSTACLES : 0),
+          game(GameRegistry::standard().idOf(gameName.substr(0, GAME_LENGTH))) {
+        setText(playerName, NAME_LENGTH, name);
+    }
+
+    // Getters
+    std::string_view getGame() const { return GameRegistry::standard().titleOf(game); }
+    uint8_t getGameId() const { return game; }
+    std::string_view getPlayerName() const { return text(playerName, NAME_LENGTH); }
+    int getScore() const { return score; }
+    ScoreDifficulty getDifficulty() const { return difficulty; }
+    std::string_view getDifficultyName() const { return difficultyName(difficulty); }
+    bool getHasObstacles() const { return (flags & OBSTACLES) != 0; }
+
+    static std::string_view difficultyName(ScoreDifficulty value) {
+        static const char* names[DIFFICULTY_COUNT] = {"", "Easy", "Medium", "Hard", "Negamax", "Monte Carlo"};
+        int index = static_cast<int>(value);
+        return names[index < DIFFICULTY_COUNT ? index : 0];
+    }
+
+    // ScoreDifficulty::None for anything unknown
+    static ScoreDifficulty difficultyFromName(std::string_view name) {
+        for (int i = 1; i < DIFFICULTY_COUNT; i++) {
+            if (difficultyName(ScoreDifficulty(i)) == name) {
+                return ScoreDifficulty(i);
+            }
+        }
+        return ScoreDifficulty::None;
+    }
+
+    // Fixed-size text fields like the name, also used by other plain records
+    static void setText(char* buffer, size_t capacity, std::string_view value) {
+        size_t length = value.size() < capacity ? value.size() : capacity;
+        std::memcpy(buffer, value.data(), length);
+        std::memset(buffer + length, 0, capacity - length);
+    }
+
+    static std::string_view text(const char* buffer, size_t capacity) {
+        const void* end = std::memchr(buffer, 0, capacity);
+        return std::string_view(buffer, end ? static_cast<const char*>(end) - buffer : capacity);
+    }
+
+    // Same submission details; equal entries rank the same everywhere
+    friend bool operator==(const ScoreEntry& a, const ScoreEntry& b) {
+        return a.score == b.score && a.difficulty == b.difficulty && a.flags == b.flags &&
+               a.game == b.game && std::memcmp(a.playerName, b.playerName, NAME_LENGTH) == 0;
+    }
+
+    friend bool operator!=(const ScoreEntry& a, const ScoreEntry& b) {
+        return !(a == b);
+    }
+
+    // Writes the row shown on high-score screens into `out`, which must hold ROW_LENGTH
+    // characters, and returns its length
+    size_t format(char* out) const {
+        size_t length = 0;
+        char number[12];
+        int digits = std::snprintf(number, sizeof(number), "%d", int(score));
+        pad(out, length, getPlayerName(), 15);
+        pad(out, length, std::string_view(number, size_t(digits)), 8);
+        pad(out, length, getDifficultyName(), 10);
+        if (getHasObstacles()) {
+            pad(out, length, " (with obstacles)", 0);
+        }
+        return length;
+    }
+
+    // Method to format score entry as string
+    std::string toString() const {
+        char row[ROW_LENGTH];
+        return std::string(row, format(row));
+    }
+
+    // Binary form used by the journal (native endianness): int32 score, uint8 obstacles,
+    // then name, difficulty and game as uint8 length + bytes
+    void encode(std::string& out) const {
+        int32_t value = score;
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        out.push_back(getHasObstacles() ? 1 : 0);
+        encodeString(out, getPlayerName());
+        encodeString(out, getDifficultyName());
+        encodeString(out, getGame());
+    }
+
+    // Reads one entry and advances data; false if the bytes are not a complete entry.
+    // Entries written before other games kept scores have no game and are Snake scores.
+    bool decode(const char*& data, const char* end, bool withGame = true) {
+        int32_t value;
+        if (end - data < static_cast<ptrdiff_t>(sizeof(value) + 1)) {
+            return false;
+        }
+        std::memcpy(&value, data, sizeof(value));
+        data += sizeof(value);
+        bool obstacles = *data++ != 0;
+        std::string_view name;
+        std::string_view diff;
+        std::string_view gameName = "Snake";
+        if (!decodeString(data, end, name) || !decodeString(data, end, diff) ||
+            (withGame && !decodeString(data, end, gameName))) {
+            return false;
+        }
+        *this = ScoreEntry(gameName, name, value, diff, obstacles);
+        return true;
+    }
+
+private:
+    // Left-aligned in a column of at least `width`, like std::left << std::setw(width)
+    static void pad(char* out, size_t& length, std::string_view value, size_t width) {
+        size_t count = value.size() < ROW_LENGTH - length ? value.size() : ROW_LENGTH - length;
+        std::memcpy(out + length, value.data(), count);
+        length += count;
+        for (size_t i = count; i < width && length < ROW_LENGTH; i++) {
+            out[length++] = ' ';
+        }
+    }
+
+    static void encodeString(std::string& out, std::string_view text) {
+        size_t length = text.size() < 255 ? text.size() : 255;
+        out.push_back(static_cast<char>(length));
+        out.append(text.data(), length);
+    }
+
+    static bool decodeString(const char*& data, const char* end, std::string_view& text) {
+        if (data >= end) {
+            return false;
+        }
+        size_t length = static_cast<uint8_t>(*data++);
+        if (static_cast<size_t>(end - data) < length) {
+            return false;
+        }
+        text = std::string_view(data, length);
+        data += length;
+        return true;
+    }
+};
+
+static_assert(std::is_trivially_copyable<ScoreEntry>::value, "ScoreEntry is copied as plain bytes");
+static_assert(sizeof(ScoreEntry) == 24, "ScoreEntry is meant to stay 24 bytes");
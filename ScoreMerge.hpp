@@ -0,0 +1,172 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ScoreEntry.hpp"
+#include "ScoreTextFile.hpp"
+
+// Consolidates leaderboard text files, e.g. collected from several machines or backups, into
+// one with a streaming k-way merge. Inputs must already be in merge order (see before()), as
+// HighScoreManager::exportSortedScores writes them; sort() puts any other file in that order.
+// Memory use does not grow with the files: each input is mapped and read one entry at a time,
+// and the output goes through a fixed buffer.
+//
+// Files hold no submission times, so one submission cannot be told from an identical one.
+// Identical entries are therefore merged as a multiset union: an entry found n1, n2, ...
+// times in the inputs is written max(n1, n2, ...) times. Merging a backup with the file it
+// was copied from adds nothing, while a file's own repeated scores are all kept.
+class ScoreMerge {
+public:
+    struct Stats {
+        size_t read = 0;
+        size_t written = 0;
+        size_t duplicates = 0;  // Read but covered by an identical entry of another input
+        size_t skipped = 0;     // Lines that did not parse
+    };
+
+    // Merge order: highest score first, then by game, difficulty, obstacles and name, so
+    // identical entries are adjacent
+    static bool before(const ScoreEntry& a, const ScoreEntry& b) {
+        if (a.getScore() != b.getScore()) {
+            return a.getScore() > b.getScore();
+        }
+        int game = a.getGame().compare(b.getGame());
+        if (game != 0) {
+            return game < 0;
+        }
+        if (a.getDifficulty() != b.getDifficulty()) {
+            return a.getDifficulty() < b.getDifficulty();
+        }
+        if (a.getHasObstacles() != b.getHasObstacles()) {
+            return b.getHasObstacles();
+        }
+        return a.getPlayerName() < b.getPlayerName();
+    }
+
+    // Writes the merged inputs to `output`, which is only replaced once complete. False, with
+    // `error` set, if an input cannot be read or is out of order, or writing fails.
+    static bool merge(const std::vector<std::string>& inputs, const std::string& output,
+                      Stats& stats, std::string& error) {
+        stats = Stats();
+        std::vector<std::unique_ptr<Input>> sources;
+        for (const auto& path : inputs) {
+            sources.emplace_back(new Input(path));
+            if (!sources.back()->reader.open(path)) {
+                error = "Cannot read " + path;
+                return false;
+            }
+            if (!sources.back()->advance(stats, error)) {
+                return false;
+            }
+        }
+
+        ScoreTextFile::Writer writer;
+        if (!writer.open(output)) {
+            error = "Cannot write " + output;
+            return false;
+        }
+
+        // Min-heap of the inputs with entries left, by their current entry
+        auto later = [&sources](size_t a, size_t b) {
+            return before(sources[b]->current, sources[a]->current);
+        };
+        std::vector<size_t> heap;
+        for (size_t i = 0; i < sources.size(); i++) {
+            if (sources[i]->more) {
+                heap.push_back(i);
+            }
+        }
+        std::make_heap(heap.begin(), heap.end(), later);
+
+        while (!heap.empty()) {
+            ScoreEntry entry = sources[heap.front()]->current;
+            size_t copies = 0;
+            size_t total = 0;
+            while (!heap.empty() && sources[heap.front()]->current == entry) {
+                std::pop_heap(heap.begin(), heap.end(), later);
+                size_t index = heap.back();
+                Input& source = *sources[index];
+                heap.pop_back();
+
+                size_t run = 0;
+                while (source.more && source.current == entry) {
+                    run++;
+                    if (!source.advance(stats, error)) {
+                        return false;
+                    }
+                }
+                copies = std::max(copies, run);
+                total += run;
+                if (source.more) {
+                    heap.push_back(index);
+                    std::push_heap(heap.begin(), heap.end(), later);
+                }
+            }
+            for (size_t i = 0; i < copies; i++) {
+                if (!writer.write(entry)) {
+                    error = "Cannot write " + output;
+                    return false;
+                }
+            }
+            stats.written += copies;
+            stats.duplicates += total - copies;
+        }
+
+        for (const auto& source : sources) {
+            stats.skipped += source->reader.getSkipped();
+        }
+        if (!writer.commit()) {
+            error = "Cannot write " + output;
+            return false;
+        }
+        return true;
+    }
+
+    // Writes `input` in merge order to `output`; the entries are sorted in memory
+    static bool sort(const std::string& input, const std::string& output, Stats& stats, std::string& error) {
+        stats = Stats();
+        std::vector<ScoreEntry> entries;
+        if (!ScoreTextFile::load(input, entries, &stats.skipped)) {
+            error = "Cannot read " + input;
+            return false;
+        }
+        std::stable_sort(entries.begin(), entries.end(), before);
+        stats.read = entries.size();
+        stats.written = entries.size();
+        if (!ScoreTextFile::save(output, entries)) {
+            error = "Cannot write " + output;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    struct Input {
+        std::string path;
+        ScoreTextFile::Reader reader;
+        ScoreEntry current;
+        bool more;
+        bool started;
+
+        explicit Input(const std::string& file) : path(file), more(false), started(false) {}
+
+        // Moves to the next entry; false, with `error` set, if it comes before the last one
+        bool advance(Stats& stats, std::string& error) {
+            ScoreEntry previous = current;
+            more = reader.next(current);
+            if (!more) {
+                return true;
+            }
+            stats.read++;
+            bool ordered = !started || !before(current, previous);
+            started = true;
+            if (!ordered) {
+                error = path + ":" + std::to_string(reader.getLine()) + ": not in merge order";
+                return false;
+            }
+            return true;
+        }
+    };
+};
@@ -0,0 +1,292 @@
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "DurableFile.hpp"
+#include "MappedFile.hpp"
+#include "ScoreEntry.hpp"
+
+// Leaderboards as text, one score per line:
+//
+//     "name" score "difficulty" obstacles "game"
+//
+// Strings are double-quoted with \" \\ \n \t escapes, so names may contain spaces. Lines in
+// the original format (name score difficulty obstacles, unquoted, Snake scores only) still
+// parse. Blank lines and lines starting with # are ignored, and a line that does not parse is
+// skipped on its own, so one bad record never affects the ones after it.
+class ScoreTextFile {
+public:
+    enum class Line { Entry, Empty, Bad };
+
+    // Parses the line at `data` and moves past it
+    static Line parse(const char*& data, const char* end, ScoreEntry& entry) {
+        const char* p = data;
+        Line result = parseFields(p, end, entry);
+        if (result != Line::Bad) {
+            skipSpaces(p, end);
+            if (p < end && *p == '\r') {
+                p++;
+            }
+            if (p < end && *p != '\n') {
+                result = Line::Bad;
+            }
+        }
+        while (p < end && *p != '\n') {
+            p++;
+        }
+        data = p < end ? p + 1 : end;
+        return result;
+    }
+
+    static void format(std::string& out, const ScoreEntry& entry) {
+        appendQuoted(out, entry.getPlayerName());
+        char number[16];
+        char* last = std::to_chars(number, number + sizeof(number), entry.getScore()).ptr;
+        out.push_back(' ');
+        out.append(number, last);
+        out.push_back(' ');
+        appendQuoted(out, entry.getDifficultyName());
+        out.append(entry.getHasObstacles() ? " 1 " : " 0 ");
+        appendQuoted(out, entry.getGame());
+        out.push_back('\n');
+    }
+
+    // Reads a whole file, in file order; false if it cannot be opened. An empty file holds no
+    // scores. `skipped`, if given, receives the number of lines that did not parse.
+    static bool load(const std::string& path, std::vector<ScoreEntry>& entries, size_t* skipped = nullptr) {
+        Reader reader;
+        if (!reader.open(path)) {
+            return false;
+        }
+        ScoreEntry entry;
+        while (reader.next(entry)) {
+            entries.push_back(entry);
+        }
+        if (skipped) {
+            *skipped = reader.getSkipped();
+        }
+        return true;
+    }
+
+    // Atomically replaces `path` with `entries`
+    static bool save(const std::string& path, const std::vector<ScoreEntry>& entries) {
+        Writer writer;
+        if (!writer.open(path)) {
+            return false;
+        }
+        for (const auto& entry : entries) {
+            writer.write(entry);
+        }
+        return writer.commit();
+    }
+
+    // Writes a file one entry at a time through a fixed-size buffer, so any number of entries
+    // takes the same memory. The file replaces `path` atomically on commit().
+    class Writer {
+    private:
+        static const size_t BUFFER_SIZE = 1 << 20;
+
+        DurableFile::Writer file;
+        std::string buffer;
+
+    public:
+        bool open(const std::string& path) {
+            buffer.clear();
+            buffer.reserve(BUFFER_SIZE + 256);
+            return file.open(path);
+        }
+
+        bool write(const ScoreEntry& entry) {
+            format(buffer, entry);
+            return buffer.size() < BUFFER_SIZE || flush();
+        }
+
+        bool commit() {
+            return flush() && file.commit();
+        }
+
+    private:
+        bool flush() {
+            bool ok = file.write(buffer.data(), buffer.size());
+            buffer.clear();
+            return ok;
+        }
+    };
+
+    // Parses a mapped file one entry at a time, skipping lines that do not parse. Pages it
+    // has read past are released as it goes, so a file of any size takes little memory.
+    class Reader {
+    private:
+        static const size_t DISCARD_EVERY = 8 << 20;
+
+        MappedFile file;
+        size_t discarded;
+        const char* position;
+        const char* end;
+        size_t skipped;
+        size_t line;
+        bool exists;
+
+    public:
+        Reader() : discarded(0), position(nullptr), end(nullptr), skipped(0), line(0), exists(false) {}
+
+        // False if the file is missing; an empty file opens with no entries
+        bool open(const std::string& path) {
+            discarded = 0;
+            skipped = 0;
+            line = 0;
+            exists = file.open(path);
+            if (!exists) {
+                std::ifstream probe(path, std::ios::binary);
+                exists = probe.is_open();
+            }
+            position = file.data();
+            end = position + file.size();
+            return exists;
+        }
+
+        bool next(ScoreEntry& entry) {
+            size_t offset = position ? size_t(position - file.data()) : 0;
+            if (offset - discarded >= DISCARD_EVERY) {
+                file.discard(offset);
+                discarded = offset;
+            }
+            while (position && position < end) {
+                Line result = parse(position, end, entry);
+                line++;
+                if (result == Line::Entry) {
+                    return true;
+                }
+                if (result == Line::Bad) {
+                    skipped++;
+                }
+            }
+            return false;
+        }
+
+        size_t getSkipped() const { return skipped; }
+
+        // 1-based line of the entry next() returned last
+        size_t getLine() const { return line; }
+    };
+
+private:
+    // Longest string kept from a field; ScoreEntry cuts names and games shorter still
+    static const size_t FIELD_LENGTH = 64;
+
+    static Line parseFields(const char*& p, const char* end, ScoreEntry& entry) {
+        skipSpaces(p, end);
+        if (p == end || *p == '\n' || *p == '\r' || *p == '#') {
+            return Line::Empty;
+        }
+
+        char name[FIELD_LENGTH];
+        char difficulty[FIELD_LENGTH];
+        char game[FIELD_LENGTH];
+        size_t nameLength;
+        size_t difficultyLength;
+        size_t gameLength = 0;
+        int score;
+        int obstacles;
+        if (!readString(p, end, name, nameLength) || !readNumber(p, end, score) ||
+            !readString(p, end, difficulty, difficultyLength) || !readNumber(p, end, obstacles) ||
+            (obstacles != 0 && obstacles != 1)) {
+            return Line::Bad;
+        }
+
+        skipSpaces(p, end);
+        bool hasGame = p < end && *p != '\n' && *p != '\r';
+        if (hasGame && !readString(p, end, game, gameLength)) {
+            return Line::Bad;
+        }
+        entry = ScoreEntry(hasGame ? std::string_view(game, gameLength) : std::string_view("Snake"),
+                           std::string_view(name, nameLength), score,
+                           std::string_view(difficulty, difficultyLength), obstacles != 0);
+        return Line::Entry;
+    }
+
+    static void skipSpaces(const char*& p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\t')) {
+            p++;
+        }
+    }
+
+    static bool isDelimiter(const char* p, const char* end) {
+        return p == end || *p == ' ' || *p == '\t' || *p == '\r' || *p == '\n';
+    }
+
+    // A quoted or bare string, unescaped into `out` and cut to FIELD_LENGTH
+    static bool readString(const char*& p, const char* end, char* out, size_t& length) {
+        skipSpaces(p, end);
+        length = 0;
+        if (p == end || *p == '\n' || *p == '\r') {
+            return false;
+        }
+        if (*p != '"') {
+            while (!isDelimiter(p, end)) {
+                if (*p == '"' || *p == '\\') {
+                    return false;
+                }
+                if (length < FIELD_LENGTH) {
+                    out[length++] = *p;
+                }
+                p++;
+            }
+            return true;
+        }
+
+        p++;
+        while (p < end && *p != '"') {
+            if (*p == '\n') {
+                return false;
+            }
+            char c = *p++;
+            if (c == '\\') {
+                if (p == end || *p == '\n') {
+                    return false;
+                }
+                c = *p++;
+                c = c == 'n' ? '\n' : c == 't' ? '\t' : c;
+            }
+            if (length < FIELD_LENGTH) {
+                out[length++] = c;
+            }
+        }
+        if (p == end) {
+            return false;
+        }
+        p++;  // Closing quote
+        return isDelimiter(p, end);
+    }
+
+    static bool readNumber(const char*& p, const char* end, int& value) {
+        skipSpaces(p, end);
+        auto parsed = std::from_chars(p, end, value);
+        if (parsed.ec != std::errc() || !isDelimiter(parsed.ptr, end)) {
+            return false;
+        }
+        p = parsed.ptr;
+        return true;
+    }
+
+    static void appendQuoted(std::string& out, std::string_view text) {
+        out.push_back('"');
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out.push_back('\\');
+                out.push_back(c);
+            } else if (c == '\n') {
+                out.append("\\n");
+            } else if (c == '\t') {
+                out.append("\\t");
+            } else {
+                out.push_back(c);
+            }
+        }
+        out.push_back('"');
+    }
+};
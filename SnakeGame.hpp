@@ -1,11 +1,15 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <algorithm>
 #include <vector>
 #include <random>
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include "FramePacer.hpp"
 #include "HighScore.hpp"
+#include "PlayerNameInput.hpp"
+#include "PlayerProfiles.hpp"
 
 struct DropdownMenu {
     sf::RectangleShape button;
@@ -142,6 +146,7 @@ private:
     // Window and rendering
     sf::RenderWindow& window;
     sf::Font& font;
+    FramePacer pacer;
     sf::Text scoreText;
 
     // Game objects
@@ -157,64 +162,151 @@ private:
     const float SPEED_EASY = 0.15f;
     const float SPEED_MEDIUM = 0.08f;
     const float SPEED_HARD = 0.05f;
+    static const int HIGH_SCORE_CHECK_MS = 250;  // How often an idle high score screen looks for new scores
 
     // Game state
     bool gameOver;
     bool showingHighScores;
     bool gameStarted;
+    bool gameRecorded;  // This game is on the leaderboard and in the player's profile
     int score;
     enum class Difficulty { EASY = 0, MEDIUM, HARD };
     Difficulty speedDifficulty;
     bool hasObstacles;
 
     // High score system
-    HighScoreManager highScoreManager;
+    HighScoreManager& highScoreManager;
     std::string playerName;
+    ScoreFilter highScoreFilter;          // View shown on the high score screen
+    // The high score screen, built when the view changes so drawing it allocates nothing
+    sf::Text highScoreTitle;
+    sf::Text highScoreViewText;
+    std::vector<sf::Text> highScoreRows;
+    sf::Text continueText;
+    sf::Text filterHelp;
+
+    std::string difficultyName() const {
+        switch (speedDifficulty) {
+            case Difficulty::EASY: return "Easy";
+            case Difficulty::MEDIUM: return "Medium";
+            case Difficulty::HARD: return "Hard";
+        }
+        return "";
+    }
 
-    void displayHighScores() {
-        window.clear(sf::Color(50, 50, 50));
+    ScoreFilter currentModeFilter() const {
+        return ScoreFilter("Snake", difficultyName(),
+                           hasObstacles ? ScoreFilter::Obstacles::With : ScoreFilter::Obstacles::Without);
+    }
+
+    void refreshHighScoreView() {
+        std::vector<ScoreEntry> shownScores = highScoreManager.getHighScores(highScoreFilter);
+
+        std::string obstacles = highScoreFilter.obstacles == ScoreFilter::Obstacles::With ? "With obstacles"
+                              : highScoreFilter.obstacles == ScoreFilter::Obstacles::Without ? "No obstacles"
+                              : "Any obstacles";
+        std::string view = highScoreFilter.game + " - " +
+            (highScoreFilter.difficulty.empty() ? "All difficulties" : highScoreFilter.difficulty) + " - " +
+            obstacles + (highScoreFilter.player.empty() ? "" : " - " + highScoreFilter.player);
 
-        sf::Text title("High Scores", font, 40);
-        title.setPosition(
-            window.getSize().x / 2 - title.getGlobalBounds().width / 2,
+        highScoreTitle = sf::Text("High Scores", font, 40);
+        highScoreTitle.setPosition(
+            window.getSize().x / 2 - highScoreTitle.getGlobalBounds().width / 2,
             50
         );
-        window.draw(title);
+
+        highScoreViewText = sf::Text(view, font, 20);
+        highScoreViewText.setPosition(
+            window.getSize().x / 2 - highScoreViewText.getGlobalBounds().width / 2,
+            105
+        );
+        highScoreViewText.setFillColor(sf::Color(200, 200, 200));
 
         float yPos = 150;
-        const auto& scores = highScoreManager.getHighScores();
-        
-        for (const auto& score : scores) {
-            sf::Text scoreText(score.toString(), font, 20);
+        char row[ScoreEntry::ROW_LENGTH];
+        highScoreRows.clear();
+        for (const auto& score : shownScores) {
+            sf::Text scoreText(std::string(row, score.format(row)), font, 20);
             scoreText.setPosition(200, yPos);
             scoreText.setFillColor(sf::Color::White);
-            window.draw(scoreText);
+            highScoreRows.push_back(scoreText);
             yPos += 40;
         }
 
-        sf::Text continueText("Press SPACE to continue", font, 24);
+        continueText = sf::Text("Press SPACE to continue", font, 24);
         continueText.setPosition(
             window.getSize().x / 2 - continueText.getGlobalBounds().width / 2,
             yPos + 50
         );
-        window.draw(continueText);
 
+        filterHelp = sf::Text("G: game   D: difficulty   O: obstacles   P: your scores", font, 16);
+        filterHelp.setPosition(
+            window.getSize().x / 2 - filterHelp.getGlobalBounds().width / 2,
+            window.getSize().y - 40
+        );
+        filterHelp.setFillColor(sf::Color(150, 150, 150));
+    }
+
+    // G: game, D: difficulty, O: obstacles, P: only your own scores
+    void changeHighScoreView(sf::Keyboard::Key key) {
+        if (key == sf::Keyboard::G) {
+            highScoreFilter = ScoreFilter(nextOption(highScoreManager.getGames(), highScoreFilter.game, false));
+        } else if (key == sf::Keyboard::D) {
+            highScoreFilter.difficulty = nextOption(highScoreManager.getDifficulties(highScoreFilter.game),
+                                                    highScoreFilter.difficulty, true);
+        } else if (key == sf::Keyboard::O) {
+            highScoreFilter.obstacles = ScoreFilter::Obstacles((int(highScoreFilter.obstacles) + 1) % 3);
+        } else if (key == sf::Keyboard::P) {
+            highScoreFilter.player = highScoreFilter.player.empty() ? playerName : "";
+        } else {
+            return;
+        }
+        refreshHighScoreView();
+    }
+
+    // The option after `current`, wrapping around; with `allowAny`, "" (any) comes first
+    static std::string nextOption(const std::vector<std::string>& options, const std::string& current, bool allowAny) {
+        std::vector<std::string> cycle;
+        if (allowAny) {
+            cycle.push_back("");
+        }
+        cycle.insert(cycle.end(), options.begin(), options.end());
+        if (cycle.empty()) {
+            return current;
+        }
+        auto found = std::find(cycle.begin(), cycle.end(), current);
+        return found == cycle.end() || found + 1 == cycle.end() ? cycle.front() : *(found + 1);
+    }
+
+    void displayHighScores() {
+        window.clear(sf::Color(50, 50, 50));
+        window.draw(highScoreTitle);
+        window.draw(highScoreViewText);
+        for (const auto& scoreText : highScoreRows) {
+            window.draw(scoreText);
+        }
+        window.draw(continueText);
+        window.draw(filterHelp);
         window.display();
     }
 
     void handleGameOver() {
-        if (gameOver && !showingHighScores) {
-            if (highScoreManager.isHighScore(score)) {
-                playerName = getPlayerName();
-                
-                std::string difficultyStr;
-                switch (speedDifficulty) {
-                    case Difficulty::EASY: difficultyStr = "Easy"; break;
-                    case Difficulty::MEDIUM: difficultyStr = "Medium"; break;
-                    case Difficulty::HARD: difficultyStr = "Hard"; break;
-                }
-                
-                highScoreManager.addScore(playerName, score, difficultyStr, hasObstacles);
+        if (gameOver && !gameRecorded) {
+            gameRecorded = true;
+            // Every game goes on the leaderboard; a name is asked for when it ranks in its mode
+            // (difficulty and obstacles), or if nobody has entered one yet
+            highScoreManager.refresh();
+            bool highScore = highScoreManager.isHighScore(currentModeFilter(), score);
+            if (highScore || !PlayerProfiles::standard().hasCurrentPlayer()) {
+                PlayerProfiles::standard().setCurrentPlayer(getPlayerName());
+            }
+            playerName = PlayerProfiles::standard().getCurrentPlayer();
+            highScoreManager.addScore(playerName, score, difficultyName(), hasObstacles);
+            PlayerProfiles::standard().recordGame("Snake", ScoreEntry::difficultyFromName(difficultyName()),
+                                                  GameResult::None, score);
+            if (highScore) {
+                highScoreFilter = currentModeFilter();
+                refreshHighScoreView();
                 showingHighScores = true;
             }
         }
@@ -229,21 +321,14 @@ private:
 
         while (window.isOpen()) {
             sf::Event event;
-            while (window.pollEvent(event)) {
-                if (event.type == sf::Event::TextEntered) {
-                    if (event.text.unicode == '\r' || event.text.unicode == '\n') {
-                        return !name.empty() ? name : "Player";
-                    }
-                    else if (event.text.unicode == '\b') {
-                        if (!name.empty()) name.pop_back();
-                    }
-                    else if (name.length() < 15 && event.text.unicode >= 32 && event.text.unicode < 127) {
-                        name += static_cast<char>(event.text.unicode);
-                    }
+            while (pacer.pollEvent(event)) {
+                if (event.type == sf::Event::TextEntered &&
+                    PlayerNameInput::apply(name, event.text.unicode) == PlayerNameInput::Result::Entered) {
+                    return name;
                 }
                 if (event.type == sf::Event::Closed) {
                     window.close();
-                    return "Player";
+                    return PlayerNameInput::DEFAULT_NAME;
                 }
             }
 
@@ -264,14 +349,16 @@ private:
             window.draw(prompt);
             window.draw(inputText);
             window.display();
+            pacer.waitEvent();
         }
-        return "Player";
+        return PlayerNameInput::DEFAULT_NAME;
     }
 
 public:
     SnakeGame(sf::RenderWindow& gameWindow, sf::Font& gameFont) 
-        : window(gameWindow), font(gameFont), gridSize(20.f), moveTimer(0.f),
-          gameOver(false), showingHighScores(false), gameStarted(false), score(0) {
+        : window(gameWindow), font(gameFont), pacer(gameWindow), gridSize(20.f), moveTimer(0.f),
+          gameOver(false), showingHighScores(false), gameStarted(false), gameRecorded(false), score(0),
+          highScoreManager(HighScoreManager::standard()) {
         
         setupGame();
     }
@@ -295,13 +382,21 @@ public:
             }
 
             if (showingHighScores) {
+                // Other consoles sharing the leaderboard may add scores meanwhile
+                if (highScoreManager.refresh()) {
+                    refreshHighScoreView();
+                }
                 displayHighScores();
+                pacer.waitEvent(sf::milliseconds(HIGH_SCORE_CHECK_MS));
             } else if (gameStarted && !gameOver) {
                 update(deltaTime);
                 render();
             } else if (gameOver) {
                 handleGameOver();
                 render();
+                if (!showingHighScores) {
+                    pacer.waitEvent();  // The game over screen only changes on input
+                }
             }
         }
     }
@@ -318,6 +413,7 @@ private:
         direction = sf::Vector2f(-gridSize, 0.f);
         score = 0;
         gameOver = false;
+        gameRecorded = false;
         showingHighScores = false;
         
         // Set speed based on difficulty
@@ -365,7 +461,7 @@ private:
 
         while (window.isOpen()) {
             sf::Event event;
-            while (window.pollEvent(event)) {
+            while (pacer.pollEvent(event)) {
                 if (event.type == sf::Event::Closed) {
                     window.close();
                     return false;
@@ -412,6 +508,7 @@ private:
             window.draw(startButtonText);
             
             window.display();
+            pacer.waitEvent();
         }
 
         delete speedDropdown;
@@ -421,7 +518,7 @@ private:
 
     bool handleEvents() {
         sf::Event event;
-        while (window.pollEvent(event)) {
+        while (pacer.pollEvent(event)) {
             if (event.type == sf::Event::Closed) {
                 window.close();
                 return false;
@@ -436,6 +533,10 @@ private:
                     return false;  // Return to main menu
                 }
 
+                if (showingHighScores) {
+                    changeHighScoreView(event.key.code);
+                }
+
                 // Only handle game controls if game is active
                 if (gameStarted && !gameOver && !showingHighScores) {
                     switch (event.key.code) {
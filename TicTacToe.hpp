@@ -1,6 +1,10 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <algorithm>
 #include <array>
+#include "FramePacer.hpp"
+#include "HighScore.hpp"
+#include "PlayerProfiles.hpp"
 
 class TicTacToe {
 private:
@@ -10,6 +14,7 @@ private:
 
     sf::RenderWindow& window;
     sf::Font& font;
+    FramePacer pacer;
     
     // Game state
     std::array<Player, 9> board;
@@ -51,7 +56,7 @@ private:
 
 public:
     TicTacToe(sf::RenderWindow& gameWindow, sf::Font& gameFont)
-        : window(gameWindow), font(gameFont), 
+        : window(gameWindow), font(gameFont), pacer(gameWindow),
           currentPlayer(Player::X), gameOver(false), showingMenu(true),
           shouldExit(false) {
         initializeGame();
@@ -62,6 +67,9 @@ public:
             handleEvents();
             update();
             render();
+            if (!shouldExit) {
+                pacer.waitEvent();  // Nothing on the board moves, so wait for input
+            }
         }
         return true;
     }
@@ -161,7 +169,7 @@ private:
 
     void handleEvents() {
         sf::Event event;
-        while (window.pollEvent(event)) {
+        while (pacer.pollEvent(event)) {
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
@@ -251,6 +259,9 @@ private:
             
             if (checkWin() || checkDraw()) {
                 gameOver = true;
+                if (gameMode == GameMode::PvC) {
+                    recordResult();
+                }
                 return;
             }
             
@@ -265,6 +276,24 @@ private:
         }
     }
 
+    // A win against the computer scores one point per empty cell left, plus one
+    void recordResult() {
+        static const char* difficultyNames[] = {"Easy", "Medium", "Hard"};
+        const char* difficulty = difficultyNames[static_cast<int>(aiDifficulty)];
+        PlayerProfiles& profiles = PlayerProfiles::standard();
+        if (!checkWin()) {
+            profiles.recordGame("Tic Tac Toe", ScoreEntry::difficultyFromName(difficulty), GameResult::Draw);
+        } else if (currentPlayer == Player::O) {
+            profiles.recordGame("Tic Tac Toe", ScoreEntry::difficultyFromName(difficulty), GameResult::Loss);
+        } else {
+            int emptyCells = int(std::count(board.begin(), board.end(), Player::None));
+            HighScoreManager::standard().addScore("Tic Tac Toe", profiles.getCurrentPlayer(), emptyCells + 1, difficulty,
+                                                  false);
+            profiles.recordGame("Tic Tac Toe", ScoreEntry::difficultyFromName(difficulty), GameResult::Win,
+                                emptyCells + 1);
+        }
+    }
+
     void makeAIMove() {
         // Simple AI implementation
         // First, check for winning move
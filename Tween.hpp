@@ -0,0 +1,87 @@
+#pragma once
+#include <algorithm>
+
+// Easing curves mapping normalized time [0, 1] to progress [0, 1]
+namespace Easing {
+    inline float linear(float t) {
+        return t;
+    }
+
+    inline float easeInQuad(float t) {
+        return t * t;
+    }
+
+    inline float easeOutQuad(float t) {
+        return t * (2.0f - t);
+    }
+
+    inline float easeInOutQuad(float t) {
+        return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+    }
+
+    inline float easeOutCubic(float t) {
+        float u = t - 1.0f;
+        return u * u * u + 1.0f;
+    }
+
+    inline float easeOutBack(float t) {
+        const float c1 = 1.70158f;
+        const float c3 = c1 + 1.0f;
+        float u = t - 1.0f;
+        return 1.0f + c3 * u * u * u + c1 * u * u;
+    }
+
+    // Falls in, then settles with three decreasing bounces
+    inline float easeOutBounce(float t) {
+        const float n1 = 7.5625f;
+        const float d1 = 2.75f;
+        if (t < 1.0f / d1) {
+            return n1 * t * t;
+        }
+        else if (t < 2.0f / d1) {
+            t -= 1.5f / d1;
+            return n1 * t * t + 0.75f;
+        }
+        else if (t < 2.5f / d1) {
+            t -= 2.25f / d1;
+            return n1 * t * t + 0.9375f;
+        }
+        t -= 2.625f / d1;
+        return n1 * t * t + 0.984375f;
+    }
+}
+
+// Interpolates a value over a fixed duration, advanced by real frame time
+class Tween {
+public:
+    using EasingFunction = float (*)(float);
+
+private:
+    float from;
+    float to;
+    float duration;
+    float elapsed;
+    EasingFunction easing;
+
+public:
+    Tween() : from(0.0f), to(0.0f), duration(0.0f), elapsed(0.0f), easing(Easing::linear) {}
+
+    Tween(float start, float end, float seconds, EasingFunction ease = Easing::linear)
+        : from(start), to(end), duration(seconds), elapsed(0.0f), easing(ease) {}
+
+    void update(float deltaTime) {
+        elapsed = std::min(elapsed + deltaTime, duration);
+    }
+
+    float progress() const {
+        return duration > 0.0f ? elapsed / duration : 1.0f;
+    }
+
+    float value() const {
+        return from + (to - from) * easing(progress());
+    }
+
+    bool isFinished() const {
+        return elapsed >= duration;
+    }
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+#include "FramePacer.hpp"
+
+// A menu of variants of one game, such as board sizes; picking one runs it and returns
+class VariantLauncher {
+public:
+    struct Variant {
+        std::string label;
+        bool (*run)(sf::RenderWindow&, sf::Font&);
+    };
+
+private:
+    struct Button {
+        sf::RectangleShape shape;
+        sf::Text text;
+        bool isHovered;
+    };
+
+    sf::RenderWindow& window;
+    sf::Font& font;
+    FramePacer pacer;
+    std::vector<Variant> variants;
+    std::vector<Button> buttons;
+    sf::Text title;
+    bool shouldExit;
+
+public:
+    VariantLauncher(sf::RenderWindow& gameWindow, sf::Font& gameFont, const std::string& titleText,
+                    float buttonWidth, std::vector<Variant> gameVariants)
+        : window(gameWindow), font(gameFont), pacer(gameWindow), variants(std::move(gameVariants)),
+          shouldExit(false) {
+        title.setFont(font);
+        title.setString(titleText);
+        title.setCharacterSize(40);
+        title.setFillColor(sf::Color::White);
+        title.setPosition((window.getSize().x - title.getGlobalBounds().width) / 2, 60);
+
+        for (size_t i = 0; i < variants.size(); i++) {
+            Button button;
+            button.shape.setSize(sf::Vector2f(buttonWidth, 50));
+            button.shape.setPosition((window.getSize().x - buttonWidth) / 2, 150 + i * 70);
+            button.shape.setFillColor(sf::Color(100, 100, 100));
+            button.text.setFont(font);
+            button.text.setString(variants[i].label);
+            button.text.setCharacterSize(24);
+            button.text.setFillColor(sf::Color::White);
+            sf::FloatRect textBounds = button.text.getGlobalBounds();
+            button.text.setPosition(
+                button.shape.getPosition().x + (buttonWidth - textBounds.width) / 2,
+                button.shape.getPosition().y + (50 - textBounds.height) / 2
+            );
+            button.isHovered = false;
+            buttons.push_back(button);
+        }
+    }
+
+    bool run() {
+        while (window.isOpen() && !shouldExit) {
+            sf::Event event;
+            while (pacer.pollEvent(event)) {
+                if (event.type == sf::Event::Closed) {
+                    window.close();
+                }
+                else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) {
+                    shouldExit = true;
+                }
+                else if (event.type == sf::Event::MouseMoved) {
+                    sf::Vector2f mousePos(event.mouseMove.x, event.mouseMove.y);
+                    for (auto& button : buttons) {
+                        button.isHovered = button.shape.getGlobalBounds().contains(mousePos);
+                        button.shape.setFillColor(
+                            button.isHovered ? sf::Color(150, 150, 150) : sf::Color(100, 100, 100)
+                        );
+                    }
+                }
+                else if (event.type == sf::Event::MouseButtonPressed) {
+                    sf::Vector2f mousePos(event.mouseButton.x, event.mouseButton.y);
+                    for (size_t i = 0; i < buttons.size(); i++) {
+                        if (buttons[i].shape.getGlobalBounds().contains(mousePos)) {
+                            variants[i].run(window, font);
+                            shouldExit = true;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            window.clear(sf::Color(50, 50, 50));
+            window.draw(title);
+            for (const auto& button : buttons) {
+                window.draw(button.shape);
+                window.draw(button.text);
+            }
+            window.display();
+            if (!shouldExit) {
+                pacer.waitEvent();
+            }
+        }
+        return true;
+    }
+};
@@ -1,4 +1,6 @@
 #include <SFML/Graphics.hpp>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <vector>
 #include <string>
@@ -6,16 +8,27 @@
 #include "TicTacToe.hpp"
 #include "RockPaperScissors.hpp"
 #include "ConnectFour.hpp"
+#include "FramePacer.hpp"
+#include "PlayerStatsScreen.hpp"
 
 class GameConsole {
 private:
     sf::RenderWindow window;
     std::vector<sf::Text> menuItems;
     sf::Font font;
+    FramePacer pacer;
     int selectedItem;
+    bool redraw;  // The menu changed, or another screen drew over it, since it was last drawn
 
 public:
-    GameConsole() : window(sf::VideoMode(800, 600), "Game Console"), selectedItem(0) {
+    static const unsigned DEFAULT_FRAME_RATE_LIMIT = 60;
+
+    // 0 leaves the frame rate uncapped
+    explicit GameConsole(unsigned frameRateLimit = DEFAULT_FRAME_RATE_LIMIT)
+        : window(sf::VideoMode(800, 600), "Game Console"), pacer(window), selectedItem(0), redraw(true) {
+        // Cap the frame rate for every screen sharing this window
+        window.setFramerateLimit(frameRateLimit);
+
         // Load font
         if (!font.loadFromFile("arial.ttf")) {
             // Handle font loading error
@@ -28,6 +41,7 @@ public:
             "Tic Tac Toe",
             "Rock Paper Scissors",
             "Connect Four",
+            "Player Stats",
             "Exit"
         };
 
@@ -46,18 +60,27 @@ public:
     void run() {
         while (window.isOpen()) {
             handleEvents();
-            update();
-            render();
+            if (redraw) {
+                update();
+                render();
+                redraw = false;
+            }
+            // Nothing on the menu moves, so it only wakes up for input
+            pacer.waitEvent();
         }
     }
 
 private:
     void handleEvents() {
         sf::Event event;
-        while (window.pollEvent(event)) {
+        while (pacer.pollEvent(event)) {
             if (event.type == sf::Event::Closed)
                 window.close();
 
+            if (event.type == sf::Event::Resized || event.type == sf::Event::GainedFocus) {
+                redraw = true;
+            }
+
             if (event.type == sf::Event::KeyPressed) {
                 if (event.key.code == sf::Keyboard::Up) {
                     moveSelection(-1);
@@ -84,11 +107,13 @@ private:
 
     void moveSelection(int direction) {
         selectedItem = (selectedItem + direction + menuItems.size()) % menuItems.size();
+        redraw = true;
     }
 
     void handleMouseHover(int x, int y) {
         for (size_t i = 0; i < menuItems.size(); i++) {
             if (menuItems[i].getGlobalBounds().contains(x, y)) {
+                redraw = redraw || selectedItem != int(i);
                 selectedItem = i;
                 break;
             }
@@ -106,6 +131,7 @@ private:
     }
 
     void handleMenuSelection() {
+        redraw = true;
         switch (selectedItem) {
             case 0: // Snake Game
                 {
@@ -121,21 +147,27 @@ private:
                 break;
             case 2: // Rock Paper Scissors
                 {
-                    RockPaperScissors game(window, font);
-                    if (game.run()) {
+                    RockPaperScissorsLauncher launcher(window, font);
+                    if (launcher.run()) {
                         selectedItem = -1;  // Reset selection
                     }
                 }
                 break;
             case 3: // Connect Four
                 {
-                    ConnectFour game(window, font);
-                    if (game.run()) {
+                    ConnectFourLauncher launcher(window, font);
+                    if (launcher.run()) {
                         selectedItem = -1;  // Reset selection
                     }
                 }
                 break;
-            case 4: // Exit
+            case 4: // Player Stats
+                {
+                    PlayerStatsScreen stats(window, font);
+                    stats.run();
+                }
+                break;
+            case 5: // Exit
                 window.close();
                 break;
         }
@@ -164,9 +196,17 @@ private:
     }
 };
 
-int main() {
+// Usage: game_console [--fps N]   (N = 0 for no frame rate cap)
+int main(int argc, char** argv) {
+    unsigned frameRateLimit = GameConsole::DEFAULT_FRAME_RATE_LIMIT;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::strcmp(argv[i], "--fps") == 0) {
+            frameRateLimit = unsigned(std::strtoul(argv[++i], nullptr, 10));
+        }
+    }
+
     try {
-        GameConsole console;
+        GameConsole console(frameRateLimit);
         console.run();
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;